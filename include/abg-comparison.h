@@ -250,6 +250,12 @@ typedef vector<changed_var_sptr> changed_var_sptrs_type;
 /// value is an @ref elf_symbol_sptr.
 typedef unordered_map<string, elf_symbol_sptr> string_elf_symbol_map;
 
+/// Convenience typedef for a map whose key is a string and whose
+/// value is a pair of @ref elf_symbol_sptr: a symbol of a first
+/// corpus and the symbol it became in a second corpus.
+typedef unordered_map<string, std::pair<elf_symbol_sptr, elf_symbol_sptr> >
+string_changed_elf_symbol_map;
+
 /// Convenience typedef for a map which key is a string and which
 /// value is a @ref var_diff_sptr.
 typedef unordered_map<string, var_diff_sptr> string_var_diff_ptr_map;
@@ -803,6 +809,9 @@ public:
   bool
   show_stats_only() const;
 
+  void
+  get_memory_usage(memory_usage_vector& usage) const;
+
   void
   show_soname_change(bool f);
 
@@ -881,6 +890,12 @@ public:
   void
   show_added_symbols_unreferenced_by_debug_info(bool f);
 
+  bool
+  show_changed_symbols_unreferenced_by_debug_info() const;
+
+  void
+  show_changed_symbols_unreferenced_by_debug_info(bool f);
+
   void show_unreachable_types(bool f);
 
   bool show_unreachable_types();
@@ -2482,6 +2497,12 @@ public:
   const string_elf_symbol_map&
   added_unrefed_variable_symbols() const;
 
+  const string_changed_elf_symbol_map&
+  changed_unrefed_function_symbols() const;
+
+  const string_changed_elf_symbol_map&
+  changed_unrefed_variable_symbols() const;
+
   const string_type_base_sptr_map&
   deleted_unreachable_types() const;
 
@@ -2664,6 +2685,12 @@ public:
   size_t net_num_removed_var_syms() const;
   size_t net_num_added_var_syms() const;
 
+  size_t num_func_syms_changed() const;
+  void num_func_syms_changed(size_t);
+
+  size_t num_var_syms_changed() const;
+  void num_var_syms_changed(size_t);
+
   size_t num_leaf_changes() const;
   void num_leaf_changes(size_t);
 
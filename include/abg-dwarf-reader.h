@@ -57,6 +57,13 @@ lookup_symbol_from_elf(const environment&		env,
 		       bool				demangle,
 		       vector<elf_symbol_sptr>&	symbols);
 
+bool
+lookup_symbols_from_elf(const environment&			env,
+			const string&				elf_path,
+			const vector<string>&			symbol_names,
+			bool					demangle,
+			vector<vector<elf_symbol_sptr>>&	symbols);
+
 bool
 lookup_public_function_symbol_from_elf(const environment&		env,
 				       const string&			path,
@@ -106,6 +106,9 @@ class reader : public fe_iface
   const string&
   alternate_dwarf_debug_info_path() const;
 
+  const string&
+  alternate_dwarf_debug_info_build_id() const;
+
   bool
   refers_to_alt_debug_info(string& alt_di_path) const;
 
@@ -66,6 +66,7 @@ protected:
     bool		do_log				= false;
     bool		leverage_dwarf_factorization	= true;
     bool		assume_odr_for_cplusplus	= true;
+    size_t		nb_worker_threads		= 1;
     options_type(environment&);
 
   };// font_end_iface::options_type
@@ -145,6 +146,9 @@ protected:
 
   virtual ir::corpus_sptr
   read_corpus(status& status) = 0;
+
+  virtual void
+  get_memory_usage(ir::memory_usage_vector& usage) const;
 }; //end class fe_iface
 
 typedef shared_ptr<fe_iface> fe_iface_sptr;
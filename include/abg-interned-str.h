@@ -16,6 +16,7 @@
 #ifndef __ABG_INTERNED_STR_H__
 #define __ABG_INTERNED_STR_H__
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <ostream>
@@ -241,6 +242,9 @@ public:
   const char*
   get_string(const char* s) const;
 
+  void
+  get_memory_usage(uint64_t& nb_strings, uint64_t& nb_bytes) const;
+
   ~interned_string_pool();
 }; // end class interned_string_pool
 
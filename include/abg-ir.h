@@ -122,6 +122,46 @@ void
 sort_types(const canonical_type_sptr_set_type& types,
 	   vector<type_base_sptr>& result);
 
+/// The approximate amount of memory used by a category of objects.
+///
+/// This is used to report where the memory of the process goes.
+struct memory_usage
+{
+  /// A description of the category of objects.
+  string	name;
+  /// The number of objects of the category.
+  uint64_t	count;
+  /// The approximate number of bytes used by the objects.
+  uint64_t	bytes;
+
+  memory_usage(const string& n, uint64_t c, uint64_t b)
+    : name(n), count(c), bytes(b)
+  {}
+};
+
+/// A convenience typedef for a vector of @ref memory_usage.
+typedef std::vector<memory_usage> memory_usage_vector;
+
+/// Compute the approximate number of bytes used by a hash table like
+/// std::unordered_map or std::unordered_set.
+///
+/// The memory owned by the elements themselves, like the characters
+/// of a string, is not counted.
+///
+/// @param t the hash table to consider.
+///
+/// @return the approximate number of bytes used by @p t.
+template<typename hash_table>
+uint64_t
+get_approximate_hash_table_size(const hash_table& t)
+{
+  // Each element lives in a node that also carries a pointer to the
+  // next node and possibly the hash value of the element.
+  return (t.size() * (sizeof(typename hash_table::value_type)
+		      + 2 * sizeof(void*))
+	  + t.bucket_count() * sizeof(void*));
+}
+
 /// This is an abstraction of the set of resources necessary to manage
 /// several aspects of the internal representations of the Abigail
 /// library.
@@ -213,6 +253,38 @@ public:
   bool
   analyze_exported_interfaces_only() const;
 
+  /// Counters about the cache of the results of type comparisons.
+  struct type_comparison_cache_stats
+  {
+    /// The number of look-ups that found a result in the cache.
+    uint64_t hits;
+    /// The number of look-ups that didn't find a result.
+    uint64_t misses;
+    /// The number of results added to the cache.
+    uint64_t insertions;
+    /// The number of results evicted from the cache because it was
+    /// full, including those dropped while the cache was growing.
+    uint64_t evictions;
+  };
+
+  size_t
+  type_comparison_cache_capacity() const;
+
+  void
+  type_comparison_cache_capacity(size_t);
+
+  type_comparison_cache_stats
+  get_type_comparison_cache_stats() const;
+
+  void
+  add_canonical_type_hint(const type_base* t, type_base* canonical);
+
+  void
+  get_memory_usage(memory_usage_vector& usage) const;
+
+  void
+  clear_canonical_type_hints();
+
 #ifdef WITH_DEBUG_SELF_COMPARISON
   void
   set_self_comparison_debug_input(const corpus_sptr& corpus);
@@ -1349,7 +1421,7 @@ class type_or_decl_base : public ir_traversable_base
   type_or_decl_base();
   type_or_decl_base(const type_or_decl_base&);
 
-protected:
+public:
 
   /// This is a bitmap type which instance is meant to contain the
   /// runtime type of a given ABI artifact.  Bits of the identifiers
@@ -1385,6 +1457,8 @@ protected:
   enum type_or_decl_kind
   kind() const;
 
+protected:
+
   void
   kind(enum type_or_decl_kind);
 
@@ -1484,6 +1558,11 @@ public:
 
   friend decl_base*
   is_decl(const type_or_decl_base* d);
+
+  template<typename T>
+  friend T*
+  runtime_type_instance_of_kind(const type_or_decl_base*,
+				type_or_decl_base::type_or_decl_kind);
 }; // end class type_or_decl_base
 
 type_or_decl_base::type_or_decl_kind
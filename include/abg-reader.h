@@ -71,6 +71,10 @@ void
 consider_types_not_reachable_from_public_interfaces(fe_iface& ctxt,
 						    bool flag);
 
+void
+set_canonical_type_hints(fe_iface& ctxt,
+			 unordered_map<string, type_base*> hints);
+
 #ifdef WITH_SHOW_TYPE_USE_IN_ABILINT
 vector<type_base_sptr>*
 get_types_from_type_id(fe_iface&, const string&);
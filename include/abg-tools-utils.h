@@ -8,6 +8,7 @@
 #ifndef __ABG_TOOLS_UTILS_H
 #define __ABG_TOOLS_UTILS_H
 
+#include <sys/types.h>
 #include <iostream>
 #include <istream>
 #include <memory>
@@ -38,12 +39,34 @@ const char* get_anonymous_subrange_internal_name_prefix();
 
 bool file_exists(const string&);
 bool is_regular_file(const string&);
+uint64_t prefetch_file(const string& path,
+		       uint64_t offset = 0,
+		       uint64_t size = 0);
 bool file_has_dwarf_debug_info(const string& elf_file_path,
 			       const vector<char**>& debug_info_root_paths);
 bool file_has_ctf_debug_info(const string& elf_file_path,
 			     const vector<char**>& debug_info_root_paths);
 bool file_has_btf_debug_info(const string& elf_file_path,
 			     const vector<char**>& debug_info_root_paths);
+
+/// Counters about the probes of ELF files for debug info made by
+/// the file_has_*_debug_info functions.
+struct debug_info_probe_stats
+{
+  /// The number of probes that actually read an ELF file.
+  uint64_t nb_probes;
+  /// The number of probes whose result was already known.
+  uint64_t nb_cached_probes;
+  /// The decompressed size of the compressed debug sections of the
+  /// ELF files probed for DWARF.
+  uint64_t nb_decompressed_bytes;
+
+  debug_info_probe_stats()
+    : nb_probes(), nb_cached_probes(), nb_decompressed_bytes()
+  {}
+};
+
+debug_info_probe_stats get_debug_info_probe_stats();
 bool is_dir(const string&);
 bool dir_exists(const string&);
 bool dir_is_empty(const string &);
@@ -59,6 +82,9 @@ void real_path(const string&path, string& realpath);
 bool ensure_dir_path_created(const string&);
 bool ensure_parent_dir_created(const string&);
 ostream& emit_prefix(const string& prog_name, ostream& out);
+void emit_memory_usage(const string& prog_name,
+		       const ir::memory_usage_vector& usage,
+		       ostream& out);
 bool check_file(const string& path, ostream& out, const string& prog_name = "");
 bool check_dir(const string& path, ostream& out, const string& prog_name="");
 bool string_ends_with(const string&, const string&);
@@ -288,6 +314,39 @@ file_type guess_file_type(istream& in);
 
 file_type guess_file_type(const string& file_path);
 
+/// The compression schemes of the abixml files that can be read and
+/// written transparently.
+enum compression_kind
+{
+  /// The file is not compressed.
+  COMPRESSION_NONE,
+  /// The file is compressed with gzip.
+  COMPRESSION_GZIP,
+  /// The file is compressed with xz.
+  COMPRESSION_XZ,
+  /// The file is compressed with zstd.
+  COMPRESSION_ZSTD
+};
+
+compression_kind
+guess_compression_kind(const string& file_path);
+
+compression_kind
+get_compression_kind_from_file_name(const string& file_path);
+
+int
+open_decompressed_file(const string& file_path,
+		       compression_kind kind,
+		       pid_t& pid);
+
+int
+open_compressed_output_file(const string& file_path,
+			    compression_kind kind,
+			    pid_t& pid);
+
+bool
+wait_for_compression_process(pid_t pid);
+
 bool
 get_rpm_name(const string& str, string& name);
 
@@ -97,6 +97,19 @@ set_common_options(write_context& ctxt, const OPTS& opts)
 void
 set_ostream(write_context& ctxt, ostream& os);
 
+bool
+set_output_file(write_context& ctxt, const string& path);
+
+bool
+close_output_file(write_context& ctxt);
+
+unsigned long long
+get_nb_bytes_written_to_output_file(const write_context& ctxt);
+
+void
+get_canonical_types_of_type_ids(const write_context& ctxt,
+				unordered_map<string, type_base*>& types);
+
 bool
 write_translation_unit(write_context&	       ctxt,
 		       const translation_unit& tu,
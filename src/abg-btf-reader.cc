@@ -20,6 +20,7 @@
 
 #include "abg-elf-helpers.h"
 #include "abg-ir-priv.h"
+#include "abg-symtab-reader.h"
 
 // <headers defining libabigail's API go under here>
 ABG_BEGIN_EXPORT_DECLARATIONS
@@ -27,6 +28,7 @@ ABG_BEGIN_EXPORT_DECLARATIONS
 #include "abg-btf-reader.h"
 #include "abg-ir.h"
 #include "abg-tools-utils.h"
+#include "abg-workers.h"
 
 ABG_END_EXPORT_DECLARATIONS
 // </headers defining libabigail's API>
@@ -57,23 +59,190 @@ btf_offset_to_string(const ::btf* btf, uint32_t offset)
 typedef std::unordered_map<int, type_or_decl_base_sptr>
 btf_type_id_to_abi_artifact_map_type;
 
+/// Test if a symbol of a given name is defined and exported.
+///
+/// This does what elf::reader::function_symbol_is_exported and
+/// elf::reader::variable_symbol_is_exported do, but it only reads
+/// the symbol table, so it can be invoked from worker threads.
+///
+/// @param symtab the symbol table to consider.  It must have been
+/// loaded already.
+///
+/// @param name the name of the symbol to consider.
+///
+/// @param is_function if true, look for a function symbol,
+/// otherwise, look for a variable symbol.
+///
+/// @param looking_at_linux_kernel_binary if true, the symbol must
+/// also be in the ksymtab.
+///
+/// @return true iff the symbol is defined and exported.
+static bool
+symbol_is_exported(const symtab_reader::symtab&	symtab,
+		   const string&			name,
+		   bool					is_function,
+		   bool					looking_at_linux_kernel_binary)
+{
+  for (const auto& s : symtab.lookup_symbol(name))
+    if ((is_function ? s->is_function() : s->is_variable())
+	&& s->is_public()
+	&& (!looking_at_linux_kernel_binary || s->is_in_ksymtab()))
+      return true;
+  return false;
+}
+
+/// Test if the IR of a given BTF type must be built when reading the
+/// BTF information.
+///
+/// The IR is built for decls (functions and variables) that have
+/// associated ELF symbols that are publicly defined and exported.
+/// The IR of the types is then built as they are reached from those
+/// decls, unless all the types are to be loaded.
+///
+/// This only reads the BTF and symbol table data, so it can be
+/// invoked from worker threads.
+///
+/// @param btf the BTF data to consider.
+///
+/// @param type_id the ID of the type to consider.
+///
+/// @param symtab the symbol table of the binary.  It must have been
+/// loaded already.
+///
+/// @param looking_at_linux_kernel_binary true if the binary is a
+/// Linux Kernel binary.
+///
+/// @param load_all_types true if the IR of all types is to be built.
+///
+/// @return true iff the IR of the type @p type_id must be built.
+static bool
+btf_type_is_ir_root(const ::btf*			btf,
+		    int					type_id,
+		    const symtab_reader::symtab&	symtab,
+		    bool				looking_at_linux_kernel_binary,
+		    bool				load_all_types)
+{
+  const btf_type* t = btf__type_by_id(btf, type_id);
+  string name;
+  if (t->name_off)
+    name = btf_offset_to_string(btf, t->name_off);
+
+  int kind = btf_kind(t);
+  if (kind == BTF_KIND_FUNC)
+    {
+      ABG_ASSERT(!name.empty());
+      return (btf_vlen(t) == BTF_FUNC_GLOBAL
+	      || btf_vlen(t) == BTF_FUNC_EXTERN
+	      || symbol_is_exported(symtab, name, /*is_function=*/true,
+				    looking_at_linux_kernel_binary));
+    }
+  else if (kind == BTF_KIND_VAR)
+    {
+      ABG_ASSERT(!name.empty());
+      return (btf_vlen(t) == BTF_VAR_GLOBAL_ALLOCATED
+	      || btf_vlen(t) == BTF_VAR_GLOBAL_EXTERN
+	      || symbol_is_exported(symtab, name, /*is_function=*/false,
+				    looking_at_linux_kernel_binary));
+    }
+  return load_all_types;
+}
+
+/// A task that determines, for a range of BTF type IDs, the types
+/// which IR must be built.  See btf_type_is_ir_root.
+class btf_ir_roots_task : public workers::task
+{
+  const ::btf*			btf_;
+  const symtab_reader::symtab&	symtab_;
+  bool				looking_at_linux_kernel_binary_;
+  bool				load_all_types_;
+  int				begin_;
+  int				end_;
+  vector<uint8_t>&		is_ir_root_;
+
+public:
+
+  /// Constructor of @ref btf_ir_roots_task.
+  ///
+  /// @param begin the first type ID of the range.
+  ///
+  /// @param end the type ID past the end of the range.
+  ///
+  /// @param is_ir_root the vector indexed by type ID in which to
+  /// record the result.  The tasks of the different ranges write to
+  /// distinct elements of it.
+  btf_ir_roots_task(const ::btf*			btf,
+		    const symtab_reader::symtab&	symtab,
+		    bool				looking_at_linux_kernel_binary,
+		    bool				load_all_types,
+		    int					begin,
+		    int					end,
+		    vector<uint8_t>&			is_ir_root)
+    : btf_(btf),
+      symtab_(symtab),
+      looking_at_linux_kernel_binary_(looking_at_linux_kernel_binary),
+      load_all_types_(load_all_types),
+      begin_(begin),
+      end_(end),
+      is_ir_root_(is_ir_root)
+  {}
+
+  virtual void
+  perform()
+  {
+    for (int type_id = begin_; type_id < end_; ++type_id)
+      is_ir_root_[type_id] =
+	btf_type_is_ir_root(btf_, type_id, symtab_,
+			    looking_at_linux_kernel_binary_,
+			    load_all_types_);
+  }
+}; // end class btf_ir_roots_task
+
 /// The BTF front-end abstraction type.
 class reader : public elf_based_reader
 {
   ::btf*				btf_handle_ = nullptr;
+  // The BTF data of the vmlinux binary of the corpus group being
+  // read, if any.  The BTF data of the Linux Kernel modules is split
+  // BTF that is parsed on top of it.
+  ::btf*				base_btf_handle_ = nullptr;
+  // The ID of the first type that is not in base_btf_handle_.
+  int					first_split_type_id_ = 1;
+  // True if btf_handle_ is the BTF data of a vmlinux binary, that
+  // can be used as the base BTF data of the modules read after it.
+  bool					btf_handle_is_vmlinux_ = false;
   translation_unit_sptr		cur_tu_;
   vector<type_base_sptr>		types_to_canonicalize_;
   btf_type_id_to_abi_artifact_map_type	btf_type_id_to_artifacts_;
 
   /// Getter of the handle to the BTF data as returned by libbpf.
   ///
+  /// If the current binary is a Linux Kernel module and the vmlinux
+  /// binary of the corpus group has been read before, the BTF data of
+  /// the module is parsed as split BTF on top of the BTF data of
+  /// vmlinux.  In that case, the IR nodes built for the types of
+  /// vmlinux are re-used rather than being built again.
+  ///
   /// @return the handle to the BTF data as returned by libbpf.
   ::btf*
   btf_handle()
   {
     if (btf_handle_ == nullptr)
       {
-	btf_handle_ = btf__parse(corpus_path().c_str(), nullptr);
+	if (base_btf_handle_)
+	  {
+#ifdef WITH_BTF__PARSE_SPLIT
+	    if (load_in_linux_kernel_mode()
+		&& elf_helpers::is_linux_kernel_module(elf_handle()))
+	      btf_handle_ = btf__parse_split(corpus_path().c_str(),
+					     base_btf_handle_);
+	    else
+#endif
+	      forget_base_btf();
+	  }
+
+	if (btf_handle_ == nullptr)
+	  btf_handle_ = btf__parse(corpus_path().c_str(), nullptr);
+
 	if (!btf_handle_)
 	  std::cerr << "Could not parse BTF information from file '"
 		    << corpus_path().c_str() << "'" << std::endl;
@@ -81,6 +250,61 @@ class reader : public elf_based_reader
     return btf_handle_;
   }
 
+  /// Drop the BTF data of the vmlinux binary used as the base of the
+  /// split BTF data of Linux Kernel modules, as well as the IR nodes
+  /// built from it.
+  void
+  forget_base_btf()
+  {
+    if (base_btf_handle_ == nullptr)
+      return;
+
+    btf__free(base_btf_handle_);
+    base_btf_handle_ = nullptr;
+    first_split_type_id_ = 1;
+    btf_type_id_to_artifacts_.clear();
+  }
+
+  /// Release the BTF data of the binary that was just read, so that
+  /// the reader can analyze another binary.
+  ///
+  /// If that binary was a vmlinux binary, its BTF data and the IR
+  /// nodes built from it are kept around to be used as the base of
+  /// the split BTF data of the Linux Kernel modules that are read
+  /// afterwards.  Otherwise, only the IR nodes built for the types of
+  /// the base BTF data are kept.
+  void
+  release_btf_handle()
+  {
+    if (btf_handle_ && btf_handle_is_vmlinux_)
+      {
+	if (base_btf_handle_ && base_btf_handle_ != btf_handle_)
+	  btf__free(base_btf_handle_);
+	base_btf_handle_ = btf_handle_;
+	first_split_type_id_ = nr_btf_types();
+#ifndef WITH_BTF__TYPE_CNT
+	// btf__get_nr_types returns the ID of the last type.
+	++first_split_type_id_;
+#endif
+      }
+    else
+      btf__free(btf_handle_);
+    btf_handle_ = nullptr;
+    btf_handle_is_vmlinux_ = false;
+
+    if (base_btf_handle_ == nullptr)
+      btf_type_id_to_artifacts_.clear();
+    else
+      // The IDs of the types that are specific to the previous
+      // module are going to be re-used by the next one.
+      for (auto i = btf_type_id_to_artifacts_.begin();
+	   i != btf_type_id_to_artifacts_.end();)
+	if (i->first >= first_split_type_id_)
+	  i = btf_type_id_to_artifacts_.erase(i);
+	else
+	  ++i;
+  }
+
   /// Getter of the environment of the current front-end.
   ///
   /// @return The environment of the current front-end.
@@ -212,6 +436,65 @@ class reader : public elf_based_reader
     return GET_NB_TYPES(const_cast<reader*>(this)->btf_handle());
   }
 
+  /// Determine the BTF types which IR must be built.  See
+  /// btf_type_is_ir_root.
+  ///
+  /// For big BTF sections like the one of vmlinux, that pre-pass is
+  /// performed on worker threads, each one handling a range of type
+  /// IDs.
+  ///
+  /// @param first_type_id the first type ID to consider.
+  ///
+  /// @param number_of_types the type ID past the last one to
+  /// consider.
+  ///
+  /// @param is_ir_root output parameter.  This is set to a vector
+  /// indexed by type ID, which elements are non-zero iff the IR of
+  /// the corresponding type must be built.
+  void
+  find_ir_roots(int first_type_id, int number_of_types,
+		vector<uint8_t>& is_ir_root)
+  {
+    is_ir_root.assign(number_of_types, 0);
+    if (first_type_id >= number_of_types)
+      return;
+
+    // Make sure the symbol table is loaded before it's read from
+    // worker threads.
+    const symtab_reader::symtab& symt = *symtab();
+    bool looking_at_linux_kernel_binary =
+      load_in_linux_kernel_mode() && elf_helpers::is_linux_kernel(elf_handle());
+    const ::btf* btf = btf_handle();
+
+    // Below that number of types per range, using worker threads is
+    // not worth it.
+    const int min_types_per_range = 4096;
+    int nb_types = number_of_types - first_type_id;
+    int nb_ranges =
+      std::min<int>(workers::get_number_of_threads(),
+		    nb_types / min_types_per_range);
+
+    if (nb_ranges <= 1)
+      {
+	btf_ir_roots_task(btf, symt, looking_at_linux_kernel_binary,
+			  options().load_all_types,
+			  first_type_id, number_of_types,
+			  is_ir_root).perform();
+	return;
+      }
+
+    workers::queue q(nb_ranges);
+    int range_size = (nb_types + nb_ranges - 1) / nb_ranges;
+    for (int b = first_type_id; b < number_of_types; b += range_size)
+      q.schedule_task
+	(std::make_shared<btf_ir_roots_task>
+	 (btf, symt, looking_at_linux_kernel_binary,
+	  options().load_all_types,
+	  b, std::min(b + range_size, number_of_types),
+	  is_ir_root));
+    q.wait_for_workers_to_complete();
+  }
+
 protected:
   reader() = delete;
 
@@ -238,7 +521,8 @@ protected:
 	     bool			linux_kernel_mode)
   {
     reset(elf_path, debug_info_root_paths);
-    btf__free(btf_handle_);
+    release_btf_handle();
+    types_to_canonicalize_.clear();
     options().load_all_types = load_all_types;
     options().load_in_linux_kernel_mode = linux_kernel_mode;
   }
@@ -303,7 +587,9 @@ public:
   /// Destructor of the btf::reader type.
   ~reader()
   {
-    btf__free(btf_handle_);
+    if (btf_handle_ != base_btf_handle_)
+      btf__free(btf_handle_);
+    btf__free(base_btf_handle_);
   }
 
   /// Read the ELF information as well as the BTF type information to
@@ -353,51 +639,34 @@ public:
     cur_tu(artificial_tu);
 
     int number_of_types = nr_btf_types();
-    int first_type_id = 1;
+    // The types of the base BTF data of a split BTF have been
+    // translated when the vmlinux binary was read.
+    int first_type_id = base_btf_handle_ ? first_split_type_id_ : 1;
+
+    // Build IR nodes only for decls (functions and variables) that
+    // have associated ELF symbols that are publicly defined and
+    // exported, unless the user asked to load all types.
+    vector<uint8_t> is_ir_root;
+    find_ir_roots(first_type_id, number_of_types, is_ir_root);
 
     // Let's cycle through whatever is described in the BTF section
-    // and emit libabigail IR for it.
+    // and emit libabigail IR for it.  This is done serially, in the
+    // order of the type IDs, as the IR of the types is shared and is
+    // not meant to be built concurrently.
     for (int type_id = first_type_id;
 	 type_id < number_of_types;
 	 ++type_id)
-      {
-	// Build IR nodes only for decls (functions and variables)
-	// that have associated ELF symbols that are publicly defined
-	// and exported, unless the user asked to load all types.
-
-	bool do_construct_ir_node = false;
-
-	const btf_type* t = btf__type_by_id(btf_handle(), type_id);
-	string name;
-	if (t->name_off)
-	  name = btf_offset_to_string(btf_handle(), t->name_off);
-
-	int kind = btf_kind(t);
-	if (kind == BTF_KIND_FUNC)
-	  {
-	    ABG_ASSERT(!name.empty());
-	    if (btf_vlen(t) == BTF_FUNC_GLOBAL
-		|| btf_vlen(t) == BTF_FUNC_EXTERN
-		|| function_symbol_is_exported(name))
-	      do_construct_ir_node = true;
-	  }
-	else if (kind == BTF_KIND_VAR)
-	  {
-	    ABG_ASSERT(!name.empty());
-	    if (btf_vlen(t) == BTF_VAR_GLOBAL_ALLOCATED
-		|| btf_vlen(t) == BTF_VAR_GLOBAL_EXTERN
-		|| variable_symbol_is_exported(name))
-	      do_construct_ir_node = true;
-	  }
-	else if (options().load_all_types)
-	  do_construct_ir_node = true;
-
-	if (do_construct_ir_node)
-	  build_ir_node_from_btf_type(type_id);
-      }
+      if (is_ir_root[type_id])
+	build_ir_node_from_btf_type(type_id);
 
     canonicalize_types();
 
+    btf_handle_is_vmlinux_ =
+      (base_btf_handle_ == nullptr
+       && load_in_linux_kernel_mode()
+       && elf_helpers::is_linux_kernel(elf_handle())
+       && !elf_helpers::is_linux_kernel_module(elf_handle()));
+
     return corpus();
   }
 
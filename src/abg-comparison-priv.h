@@ -210,6 +210,7 @@ struct diff_context::priv
   bool					show_redundant_changes_;
   bool					show_syms_unreferenced_by_di_;
   bool					show_added_syms_unreferenced_by_di_;
+  bool					show_changed_syms_unreferenced_by_di_;
   bool					show_unreachable_types_;
   bool					show_impacted_interfaces_;
   bool					dump_diff_tree_;
@@ -241,6 +242,7 @@ struct diff_context::priv
       show_redundant_changes_(true),
       show_syms_unreferenced_by_di_(true),
       show_added_syms_unreferenced_by_di_(true),
+      show_changed_syms_unreferenced_by_di_(false),
       show_unreachable_types_(false),
       show_impacted_interfaces_(true),
       dump_diff_tree_(),
@@ -1066,6 +1068,8 @@ struct corpus_diff::priv
   string_elf_symbol_map		suppressed_added_unrefed_var_syms_;
   string_elf_symbol_map		deleted_unrefed_var_syms_;
   string_elf_symbol_map		suppressed_deleted_unrefed_var_syms_;
+  string_changed_elf_symbol_map	changed_unrefed_fn_syms_;
+  string_changed_elf_symbol_map	changed_unrefed_var_syms_;
   edit_script				unreachable_types_edit_script_;
   string_type_base_sptr_map		deleted_unreachable_types_;
   vector<type_base_sptr>		deleted_unreachable_types_sorted_;
@@ -1330,6 +1334,8 @@ struct corpus_diff::diff_stats::priv
   size_t		num_removed_var_syms_filtered_out;
   size_t		num_var_syms_added;
   size_t		num_added_var_syms_filtered_out;
+  size_t		num_func_syms_changed;
+  size_t		num_var_syms_changed;
   size_t		num_leaf_changes;
   size_t		num_leaf_changes_filtered_out;
   size_t		num_leaf_type_changes;
@@ -1368,6 +1374,8 @@ struct corpus_diff::diff_stats::priv
       num_removed_var_syms_filtered_out(),
       num_var_syms_added(),
       num_added_var_syms_filtered_out(),
+      num_func_syms_changed(),
+      num_var_syms_changed(),
       num_leaf_changes(),
       num_leaf_changes_filtered_out(),
       num_leaf_type_changes(),
@@ -1653,6 +1653,41 @@ bool
 diff_context::show_stats_only() const
 {return priv_->show_stats_only_;}
 
+/// Compute the approximate memory used by the main data structures
+/// of the diff context.
+///
+/// This reports the diff nodes kept alive by the context, the map of
+/// the diff nodes of pairs of artifacts, the canonical diff nodes
+/// and the set of visited diff nodes.  For the diff nodes, only the
+/// memory of the node objects and their private data is counted.
+///
+/// @param usage the vector where to append the memory usage of each
+/// data structure.
+void
+diff_context::get_memory_usage(memory_usage_vector& usage) const
+{
+  usage.push_back
+    (memory_usage("live diff nodes",
+		  priv_->live_diffs_.size(),
+		  get_approximate_hash_table_size(priv_->live_diffs_)
+		  + priv_->live_diffs_.size()
+		  * (sizeof(diff) + sizeof(diff::priv))));
+  usage.push_back
+    (memory_usage("artifacts diff map",
+		  priv_->types_or_decls_diff_map.size(),
+		  get_approximate_hash_table_size
+		  (priv_->types_or_decls_diff_map)));
+  usage.push_back
+    (memory_usage("canonical diff nodes",
+		  priv_->canonical_diffs.size(),
+		  priv_->canonical_diffs.capacity() * sizeof(diff_sptr)));
+  usage.push_back
+    (memory_usage("visited diff nodes",
+		  priv_->visited_diff_nodes_.size(),
+		  get_approximate_hash_table_size
+		  (priv_->visited_diff_nodes_)));
+}
+
 /// Setter for the property that says if the comparison module should
 /// show the soname changes in its report.
 ///
@@ -1834,6 +1869,29 @@ void
 diff_context::show_added_symbols_unreferenced_by_debug_info(bool f)
 {priv_->show_added_syms_unreferenced_by_di_ = f;}
 
+/// Getter for the flag that indicates if changes to the size, CRC,
+/// namespace or version of symbols not referenced by any debug info
+/// are to be reported about.
+///
+/// @return true iff changes to symbols not referenced by any debug
+/// info are to be reported about.
+bool
+diff_context::show_changed_symbols_unreferenced_by_debug_info() const
+{return priv_->show_changed_syms_unreferenced_by_di_;}
+
+/// Setter for the flag that indicates if changes to the size, CRC,
+/// namespace or version of symbols not referenced by any debug info
+/// are to be reported about.
+///
+/// Note that this needs to be set before the corpus diff is
+/// computed.
+///
+/// @param f the new flag that says if changes to symbols not
+/// referenced by any debug info are to be reported about.
+void
+diff_context::show_changed_symbols_unreferenced_by_debug_info(bool f)
+{priv_->show_changed_syms_unreferenced_by_di_ = f;}
+
 /// Setter for the flag that indicates if changes on types unreachable
 /// from global functions and variables are to be reported.
 ///
@@ -8778,6 +8836,42 @@ corpus_diff::diff_stats::net_num_added_var_syms() const
   return num_var_syms_added() - num_added_var_syms_filtered_out();
 }
 
+/// Getter for the number of function symbols not referenced by any
+/// debug info that got changed.
+///
+/// @return the number of changed function symbols not referenced by
+/// any debug info.
+size_t
+corpus_diff::diff_stats::num_func_syms_changed() const
+{return priv_->num_func_syms_changed;}
+
+/// Setter for the number of function symbols not referenced by any
+/// debug info that got changed.
+///
+/// @param n the new number of changed function symbols not
+/// referenced by any debug info.
+void
+corpus_diff::diff_stats::num_func_syms_changed(size_t n)
+{priv_->num_func_syms_changed = n;}
+
+/// Getter for the number of variable symbols not referenced by any
+/// debug info that got changed.
+///
+/// @return the number of changed variable symbols not referenced by
+/// any debug info.
+size_t
+corpus_diff::diff_stats::num_var_syms_changed() const
+{return priv_->num_var_syms_changed;}
+
+/// Setter for the number of variable symbols not referenced by any
+/// debug info that got changed.
+///
+/// @param n the new number of changed variable symbols not
+/// referenced by any debug info.
+void
+corpus_diff::diff_stats::num_var_syms_changed(size_t n)
+{priv_->num_var_syms_changed = n;}
+
 /// Getter of the number of leaf type change diff nodes.
 ///
 /// @return the number of leaf type change diff nodes.
@@ -9179,6 +9273,91 @@ corpus_diff::priv::clear_lookup_tables()
   changed_vars_map_.clear();
 }
 
+/// Compute the changes undergone by ELF symbols that are not
+/// referenced by any debug info.
+///
+/// A symbol of the first corpus is considered changed if the second
+/// corpus has a symbol of the same name and version, but with a
+/// different size, CRC or namespace.
+///
+/// A symbol is also considered changed if it got deleted while the
+/// only symbol that got added with the same name has a different
+/// version.  In that case, the pair of symbols is moved away from
+/// the maps of deleted and added symbols.
+///
+/// @param first_syms the symbols of the first corpus that are not
+/// referenced by any debug info.
+///
+/// @param second the second corpus.
+///
+/// @param are_fn_syms true iff @p first_syms are function symbols.
+/// Otherwise, they are variable symbols.
+///
+/// @param deleted_syms the map of deleted symbols.  This is updated
+/// for the symbols which version changed.
+///
+/// @param added_syms the map of added symbols.  This is updated for
+/// the symbols which version changed.
+///
+/// @param changed_syms output parameter.  This is populated with the
+/// changed symbols, keyed by the ID string of their first version.
+static void
+compute_changed_unrefed_symbols(const elf_symbols&		first_syms,
+				const corpus&			second,
+				bool				are_fn_syms,
+				string_elf_symbol_map&		deleted_syms,
+				string_elf_symbol_map&		added_syms,
+				string_changed_elf_symbol_map&	changed_syms)
+{
+  for (elf_symbols::const_iterator i = first_syms.begin();
+       i != first_syms.end();
+       ++i)
+    {
+      const elf_symbol_sptr& sym1 = *i;
+      elf_symbol_sptr sym2 = are_fn_syms
+	? second.lookup_function_symbol(*sym1)
+	: second.lookup_variable_symbol(*sym1);
+      if (!sym2)
+	continue;
+
+      if (sym1->get_size() != sym2->get_size()
+	  || sym1->get_crc() != sym2->get_crc()
+	  || sym1->get_namespace() != sym2->get_namespace())
+	changed_syms[sym1->get_id_string()] = std::make_pair(sym1, sym2);
+    }
+
+  // Now pair the symbols which only changed version.
+  unordered_map<string, vector<string> > deleted_ids, added_ids;
+  for (string_elf_symbol_map::const_iterator i = deleted_syms.begin();
+       i != deleted_syms.end();
+       ++i)
+    deleted_ids[i->second->get_name()].push_back(i->first);
+  for (string_elf_symbol_map::const_iterator i = added_syms.begin();
+       i != added_syms.end();
+       ++i)
+    added_ids[i->second->get_name()].push_back(i->first);
+
+  for (unordered_map<string, vector<string> >::const_iterator i =
+	 deleted_ids.begin();
+       i != deleted_ids.end();
+       ++i)
+    {
+      unordered_map<string, vector<string> >::const_iterator j =
+	added_ids.find(i->first);
+      if (i->second.size() != 1
+	  || j == added_ids.end()
+	  || j->second.size() != 1)
+	continue;
+
+      const string& deleted_id = i->second.front();
+      const string& added_id = j->second.front();
+      changed_syms[deleted_id] = std::make_pair(deleted_syms[deleted_id],
+						added_syms[added_id]);
+      deleted_syms.erase(deleted_id);
+      added_syms.erase(added_id);
+    }
+}
+
 /// If the lookup tables are not yet built, walk the differences and
 /// fill the lookup tables.
 void
@@ -9513,6 +9692,23 @@ corpus_diff::priv::ensure_lookup_tables_populated()
       }
   }
 
+  // Compare the symbols that are not referenced by any debug info
+  // and that are present in both corpora.  This is a pure symbol
+  // table comparison, so it's only done when asked for.
+  if (get_context()->show_changed_symbols_unreferenced_by_debug_info())
+    {
+      compute_changed_unrefed_symbols(first_->get_unreferenced_function_symbols(),
+				      *second_, /*are_fn_syms=*/true,
+				      deleted_unrefed_fn_syms_,
+				      added_unrefed_fn_syms_,
+				      changed_unrefed_fn_syms_);
+      compute_changed_unrefed_symbols(first_->get_unreferenced_variable_symbols(),
+				      *second_, /*are_fn_syms=*/false,
+				      deleted_unrefed_var_syms_,
+				      added_unrefed_var_syms_,
+				      changed_unrefed_var_syms_);
+    }
+
   // Handle the unreachable_types_edit_script_
   {
     edit_script& e = unreachable_types_edit_script_;
@@ -10341,6 +10537,8 @@ corpus_diff::priv::apply_filters_and_compute_diff_stats(diff_stats& stat)
   stat.num_added_var_syms_filtered_out(suppressed_added_unrefed_var_syms_.size());
   stat.num_var_syms_removed(deleted_unrefed_var_syms_.size());
   stat.num_removed_var_syms_filtered_out(suppressed_deleted_unrefed_var_syms_.size());
+  stat.num_func_syms_changed(changed_unrefed_fn_syms_.size());
+  stat.num_var_syms_changed(changed_unrefed_var_syms_.size());
 
   // Walk the general leaf type diff nodes to count them
   {
@@ -10443,7 +10641,9 @@ corpus_diff::priv::emit_diff_stats(const diff_stats&	s,
     s.net_num_removed_func_syms() +
     s.net_num_added_func_syms() +
     s.net_num_removed_var_syms() +
-    s.net_num_added_var_syms();
+    s.net_num_added_var_syms() +
+    s.num_func_syms_changed() +
+    s.num_var_syms_changed();
 
   if (!sonames_equal_)
     out << indent << "ELF SONAME changed\n";
@@ -10621,12 +10821,18 @@ corpus_diff::priv::emit_diff_stats(const diff_stats&	s,
       && (s.num_func_syms_removed()
 	  || s.num_func_syms_added()
 	  || s.num_var_syms_removed()
-	  || s.num_var_syms_added()))
+	  || s.num_var_syms_added()
+	  || s.num_func_syms_changed()
+	  || s.num_var_syms_changed()))
     {
+      bool show_changed_syms =
+	ctxt->show_changed_symbols_unreferenced_by_debug_info();
+
       // function symbols changes summary.
 
       if (!ctxt->show_added_symbols_unreferenced_by_debug_info()
 	  && s.num_func_syms_removed() == 0
+	  && s.num_func_syms_changed() == 0
 	  && s.num_func_syms_added() != 0)
 	// If the only unreferenced function symbol change is function
 	// syms that got added, but we were forbidden to show function
@@ -10641,12 +10847,16 @@ corpus_diff::priv::emit_diff_stats(const diff_stats&	s,
 	    out << " (" << s.num_removed_func_syms_filtered_out()
 		<< " filtered out)";
 	  out << ", ";
+	  if (show_changed_syms)
+	    out << s.num_func_syms_changed() << " Changed, ";
 	  out << s.net_num_added_func_syms() << " Added";
 	  if (s.num_added_func_syms_filtered_out())
 	    out << " (" << s.num_added_func_syms_filtered_out()
 		<< " filtered out)";
 	  out << " function symbol";
-	  if (s.num_func_syms_added() + s.num_func_syms_removed() > 1)
+	  if (s.num_func_syms_added()
+	      + s.num_func_syms_removed()
+	      + s.num_func_syms_changed() > 1)
 	    out << "s";
 	  out << " not referenced by debug info\n";
 	}
@@ -10655,6 +10865,7 @@ corpus_diff::priv::emit_diff_stats(const diff_stats&	s,
 
       if (!ctxt->show_added_symbols_unreferenced_by_debug_info()
 	  && s.num_var_syms_removed() == 0
+	  && s.num_var_syms_changed() == 0
 	  && s.num_var_syms_added() != 0)
 	// If the only unreferenced variable symbol change is variable
 	// syms that got added, but we were forbidden to show variable
@@ -10669,12 +10880,16 @@ corpus_diff::priv::emit_diff_stats(const diff_stats&	s,
 	    out << " (" << s.num_removed_var_syms_filtered_out()
 		<< " filtered out)";
 	  out << ", ";
+	  if (show_changed_syms)
+	    out << s.num_var_syms_changed() << " Changed, ";
 	  out << s.net_num_added_var_syms() << " Added";
 	  if (s.num_added_var_syms_filtered_out())
 	    out << " (" << s.num_added_var_syms_filtered_out()
 		<< " filtered out)";
 	  out << " variable symbol";
-	  if (s.num_var_syms_added() + s.num_var_syms_removed() > 1)
+	  if (s.num_var_syms_added()
+	      + s.num_var_syms_removed()
+	      + s.num_var_syms_changed() > 1)
 	    out << "s";
 	  out << " not referenced by debug info\n";
 	}
@@ -11037,6 +11252,32 @@ const string_elf_symbol_map&
 corpus_diff::added_unrefed_variable_symbols() const
 {return priv_->added_unrefed_var_syms_;}
 
+/// Getter for function symbols not referenced by any debug info and
+/// that got changed.
+///
+/// These are only computed if
+/// diff_context::show_changed_symbols_unreferenced_by_debug_info()
+/// is set.
+///
+/// @return a map of pairs of elf function symbols not referenced by
+/// any debug info and that got changed.
+const string_changed_elf_symbol_map&
+corpus_diff::changed_unrefed_function_symbols() const
+{return priv_->changed_unrefed_fn_syms_;}
+
+/// Getter for variable symbols not referenced by any debug info and
+/// that got changed.
+///
+/// These are only computed if
+/// diff_context::show_changed_symbols_unreferenced_by_debug_info()
+/// is set.
+///
+/// @return a map of pairs of elf variable symbols not referenced by
+/// any debug info and that got changed.
+const string_changed_elf_symbol_map&
+corpus_diff::changed_unrefed_variable_symbols() const
+{return priv_->changed_unrefed_var_syms_;}
+
 /// Getter for a map of deleted types that are not reachable from
 /// global functions/variables.
 ///
@@ -11151,11 +11392,40 @@ corpus_diff::has_changes() const
 	       && priv_->deleted_unrefed_fn_syms_.empty()
 	       && priv_->added_unrefed_var_syms_.empty()
 	       && priv_->deleted_unrefed_var_syms_.empty()
+	       && priv_->changed_unrefed_fn_syms_.empty()
+	       && priv_->changed_unrefed_var_syms_.empty()
 	       && priv_->deleted_unreachable_types_.empty()
 	       && priv_->added_unreachable_types_.empty()
 	       && priv_->changed_unreachable_types_.empty()));
 }
 
+/// Test if some changed ELF symbols can't be resolved anymore by the
+/// binaries that were linked against their former version.
+///
+/// That is the case of the symbols which version, CRC or namespace
+/// changed.
+///
+/// @param syms the map of changed symbols to consider.
+///
+/// @return true iff at least one of the symbols of @p syms has its
+/// version, CRC or namespace changed.
+static bool
+has_unresolvable_symbol_changes(const string_changed_elf_symbol_map& syms)
+{
+  for (string_changed_elf_symbol_map::const_iterator i = syms.begin();
+       i != syms.end();
+       ++i)
+    {
+      const elf_symbol_sptr& sym1 = i->second.first;
+      const elf_symbol_sptr& sym2 = i->second.second;
+      if (sym1->get_version() != sym2->get_version()
+	  || sym1->get_crc() != sym2->get_crc()
+	  || sym1->get_namespace() != sym2->get_namespace())
+	return true;
+    }
+  return false;
+}
+
 /// Test if the current instance of @ref corpus_diff carries changes
 /// that we are sure are incompatible.  By incompatible change we mean
 /// a change that "breaks" the ABI of the corpus we are looking at.
@@ -11165,6 +11435,7 @@ corpus_diff::has_changes() const
 ///
 ///   - a soname change
 ///   - if exported functions or variables got removed
+///   - if the version, CRC or namespace of an ELF symbol changed
 ///
 /// Note that subtype changes *can* represent changes that break ABI
 /// too.  But they also can be changes that are OK, ABI-wise.
@@ -11194,6 +11465,8 @@ corpus_diff::has_incompatible_changes() const
 	  || stats.net_num_vars_removed() != 0
 	  || stats.net_num_removed_func_syms() != 0
 	  || stats.net_num_removed_var_syms() != 0
+	  || has_unresolvable_symbol_changes(priv_->changed_unrefed_fn_syms_)
+	  || has_unresolvable_symbol_changes(priv_->changed_unrefed_var_syms_)
 	  || stats.net_num_removed_unreachable_types() != 0
 	  || stats.net_num_changed_unreachable_types() != 0);
 }
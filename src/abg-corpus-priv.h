@@ -81,6 +81,14 @@ class corpus::exported_decls_builder::priv
   regex_t_sptrs_type	compiled_vars_keep_regexps_;
   strings_type&	sym_id_of_fns_to_keep_;
   strings_type&	sym_id_of_vars_to_keep_;
+  // The sets of the name and version keys (see symbol_key) of the
+  // elements of sym_id_of_fns_to_keep_ and sym_id_of_vars_to_keep_,
+  // along with whether they are up to date.  They are built lazily
+  // and are forgotten whenever the vectors of IDs might be modified.
+  std::unordered_set<string>	fn_keys_to_keep_;
+  bool				fn_keys_to_keep_are_built_ = false;
+  std::unordered_set<string>	var_keys_to_keep_;
+  bool				var_keys_to_keep_are_built_ = false;
 
 public:
 
@@ -490,6 +498,65 @@ public:
   sym_id_of_vars_to_keep() const
   {return sym_id_of_vars_to_keep_;}
 
+  /// Build the key of a symbol name and version in the sets of
+  /// symbols to keep.
+  ///
+  /// @param name the name of the symbol.
+  ///
+  /// @param version the version string of the symbol.
+  ///
+  /// @return the key.
+  static string
+  symbol_key(const string& name, const string& version)
+  {return name + '@' + version;}
+
+  /// Forget the sets of keys built from the IDs of the symbols to
+  /// keep.
+  ///
+  /// This must be called whenever the vectors of IDs of the symbols
+  /// to keep might be modified.
+  void
+  forget_keys_of_sym_ids_to_keep()
+  {
+    fn_keys_to_keep_.clear();
+    fn_keys_to_keep_are_built_ = false;
+    var_keys_to_keep_.clear();
+    var_keys_to_keep_are_built_ = false;
+  }
+
+  /// Build a set of the name and version keys of a vector of symbol
+  /// IDs, unless it is already up to date.
+  ///
+  /// The vector of IDs is checked once per symbol this way, instead
+  /// of having each of the IDs parsed and compared for each symbol.
+  ///
+  /// @param ids the symbol IDs to consider.
+  ///
+  /// @param keys_are_built true iff @p keys is up to date with
+  /// respect to @p ids.  This is set to true by this function.
+  ///
+  /// @param keys the set of keys to build.
+  static void
+  build_keys_of_sym_ids(const strings_type&		ids,
+			bool&				keys_are_built,
+			std::unordered_set<string>&	keys)
+  {
+    if (keys_are_built)
+      return;
+
+    keys.clear();
+    keys.reserve(ids.size());
+    for (const auto& id : ids)
+      {
+	string sym_name, sym_version;
+	ABG_ASSERT(elf_symbol::get_name_and_version_from_id(id,
+							    sym_name,
+							    sym_version));
+	keys.insert(symbol_key(sym_name, sym_version));
+      }
+    keys_are_built = true;
+  }
+
   /// Look at the set of functions to keep and tell if if a given
   /// function is to be kept, according to that set.
   ///
@@ -510,22 +577,11 @@ public:
 	  keep = false;
 	if (!keep)
 	  {
-	    for (vector<string>::const_iterator i =
-		   sym_id_of_fns_to_keep().begin();
-		 i != sym_id_of_fns_to_keep().end();
-		 ++i)
-	      {
-		string sym_name, sym_version;
-		ABG_ASSERT(elf_symbol::get_name_and_version_from_id(*i,
-								    sym_name,
-								    sym_version));
-		if (sym_name == sym->get_name()
-		    && sym_version == sym->get_version().str())
-		  {
-		    keep = true;
-		    break;
-		  }
-	      }
+	    build_keys_of_sym_ids(sym_id_of_fns_to_keep(),
+				  fn_keys_to_keep_are_built_,
+				  fn_keys_to_keep_);
+	    keep = fn_keys_to_keep_.count(symbol_key(sym->get_name(),
+						     sym->get_version().str()));
 	  }
       }
     else
@@ -617,22 +673,11 @@ public:
 	  keep = false;
 	if (!keep)
 	  {
-	    for (vector<string>::const_iterator i =
-		   sym_id_of_vars_to_keep().begin();
-		 i != sym_id_of_vars_to_keep().end();
-		 ++i)
-	      {
-		string sym_name, sym_version;
-		ABG_ASSERT(elf_symbol::get_name_and_version_from_id(*i,
-								    sym_name,
-								    sym_version));
-		if (sym_name == sym->get_name()
-		    && sym_version == sym->get_version().str())
-		  {
-		    keep = true;
-		    break;
-		  }
-	      }
+	    build_keys_of_sym_ids(sym_id_of_vars_to_keep(),
+				  var_keys_to_keep_are_built_,
+				  var_keys_to_keep_);
+	    keep = var_keys_to_keep_.count(symbol_key(sym->get_name(),
+						      sym->get_version().str()));
 	  }
       }
     else
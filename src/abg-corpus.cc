@@ -13,6 +13,7 @@
 #include <cstring>
 #include <stdexcept>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "abg-internal.h"
 
@@ -441,6 +442,10 @@ corpus::priv::get_unreferenced_function_symbols() const
 		  refed_funs[a->get_id_string()] = true;
 	      }
 
+	  const std::unordered_set<string>
+	    ids_to_keep(sym_id_fns_to_keep.begin(),
+			sym_id_fns_to_keep.end());
+
 	  auto filter = symtab_->make_filter();
 	  filter.set_functions();
 	  for (const auto& symbol :
@@ -449,15 +454,8 @@ corpus::priv::get_unreferenced_function_symbols() const
 	      const std::string sym_id = symbol->get_id_string();
 	      if (refed_funs.find(sym_id) == refed_funs.end())
 		{
-		  bool keep = sym_id_fns_to_keep.empty();
-		  for (const auto& id : sym_id_fns_to_keep)
-		    {
-		      if (id == sym_id)
-			{
-			  keep = true;
-			  break;
-			}
-		    }
+		  bool keep = (sym_id_fns_to_keep.empty()
+			       || ids_to_keep.count(sym_id));
 		  if (keep)
 		    unrefed_fun_symbols->push_back(symbol);
 		}
@@ -585,6 +583,10 @@ corpus::priv::get_unreferenced_variable_symbols() const
 		  refed_vars[a->get_id_string()] = true;
 	      }
 
+	  const std::unordered_set<string>
+	    ids_to_keep(sym_id_vars_to_keep.begin(),
+			sym_id_vars_to_keep.end());
+
 	  auto filter = symtab_->make_filter();
 	  filter.set_variables();
 	  for (const auto& symbol :
@@ -593,15 +595,8 @@ corpus::priv::get_unreferenced_variable_symbols() const
 	      const std::string sym_id = symbol->get_id_string();
 	      if (refed_vars.find(sym_id) == refed_vars.end())
 		{
-		  bool keep = sym_id_vars_to_keep.empty();
-		  for (const auto& id : sym_id_vars_to_keep)
-		    {
-		      if (id == sym_id)
-			{
-			  keep = true;
-			  break;
-			}
-		    }
+		  bool keep = (sym_id_vars_to_keep.empty()
+			       || ids_to_keep.count(sym_id));
 		  if (keep)
 		    unrefed_var_symbols->push_back(symbol);
 		}
@@ -1474,10 +1469,17 @@ corpus::get_regex_patterns_of_fns_to_keep() const
 /// A symbol ID is a string made of the name of the symbol and its
 /// version, separated by one or two '@'.
 ///
+/// As the returned vector can be modified, this makes the exported
+/// decls builder forget what it has computed from it.
+///
 /// @return a vector of IDs of function symbols to keep.
 vector<string>&
 corpus::get_sym_ids_of_fns_to_keep()
-{return priv_->sym_id_fns_to_keep;}
+{
+  if (priv_->exported_decls_builder)
+    priv_->exported_decls_builder->priv_->forget_keys_of_sym_ids_to_keep();
+  return priv_->sym_id_fns_to_keep;
+}
 
 /// Getter for the vector of function symbol IDs to keep.
 ///
@@ -1514,10 +1516,17 @@ corpus::get_regex_patterns_of_vars_to_keep() const
 /// A symbol ID is a string made of the name of the symbol and its
 /// version, separated by one or two '@'.
 ///
+/// As the returned vector can be modified, this makes the exported
+/// decls builder forget what it has computed from it.
+///
 /// @return a vector of IDs of variable symbols to keep.
 vector<string>&
 corpus::get_sym_ids_of_vars_to_keep()
-{return priv_->sym_id_vars_to_keep;}
+{
+  if (priv_->exported_decls_builder)
+    priv_->exported_decls_builder->priv_->forget_keys_of_sym_ids_to_keep();
+  return priv_->sym_id_vars_to_keep;
+}
 
 /// Getter for the vector of variable symbol IDs to keep.
 ///
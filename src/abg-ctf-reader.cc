@@ -18,6 +18,7 @@
 #include <iostream>
 #include <memory>
 #include <map>
+#include <unordered_map>
 #include <algorithm>
 
 #include "ctf-api.h"
@@ -114,7 +115,7 @@ static void
 fill_ctf_section(const Elf_Scn *elf_section, ctf_sect_t *ctf_section);
 
 static ctf_id_t
-lookup_symbol_in_ctf_archive(ctf_archive_t *ctfa, ctf_dict_t **ctf_dict,
+lookup_symbol_in_ctf_archive(reader *rdr, ctf_dict_t **ctf_dict,
                              const char *sym_name);
 
 static std::string
@@ -134,6 +135,13 @@ class reader : public elf_based_reader
   /// is used to reuse already generated types.
   string_type_base_sptr_map_type types_map;
 
+  /// The types added to types_map since the last time types were
+  /// canonicalized.  In the Linux Kernel case, types_map is kept
+  /// from one module to the next, so that the types of the parent
+  /// dictionary are translated only once; only the types that are
+  /// new to each module then need to be canonicalized.
+  vector<type_base_sptr> types_to_canonicalize;
+
   /// A set associating unknown CTF type ids
   std::set<ctf_id_t> unknown_types_set;
 
@@ -144,6 +152,32 @@ class reader : public elf_based_reader
   ctf_sect_t strtab_sect;
   translation_unit_sptr cur_tu_;
 
+  /// An entry of the index of the symbols described by the
+  /// dictionaries of the CTF archive.
+  struct ctfa_symbol
+  {
+    /// The index of the name of the dictionary describing the symbol,
+    /// in ctfa_dict_names.
+    size_t dict_index;
+    /// The CTF type ID of the symbol, in that dictionary.
+    ctf_id_t type;
+  };
+
+  /// The names of the dictionaries of the CTF archive.
+  vector<string> ctfa_dict_names;
+
+  /// An index associating the name of a symbol to the first
+  /// dictionary of the CTF archive that describes it.  It's built
+  /// lazily, by a single sweep of the archive, and is then used for
+  /// all the symbol lookups in the archive.  In the Linux Kernel case,
+  /// it is thus built only once for the whole corpus group.
+  std::unordered_map<string, ctfa_symbol> ctfa_symbol_index;
+  bool ctfa_symbol_index_built;
+
+  /// The dictionaries opened to look up symbols through
+  /// ctfa_symbol_index, keyed by name.
+  std::unordered_map<string, ctf_dict_t*> ctfa_opened_dicts;
+
 public:
 
   /// Getter of the exported decls builder object.
@@ -164,7 +198,8 @@ public:
   add_type(ctf_dict_t *dic, ctf_id_t ctf_type, type_base_sptr type)
   {
     string key = dic_type_key(dic, ctf_type);
-    types_map.insert(std::make_pair(key, type));
+    if (types_map.insert(std::make_pair(key, type)).second)
+      types_to_canonicalize.push_back(type);
   }
 
   /// Insert a given CTF unknown type ID.
@@ -201,13 +236,18 @@ public:
   { return unknown_types_set.find(ctf_type) != unknown_types_set.end(); }
 
   /// Canonicalize all the types stored in the types map.
+  ///
+  /// Only the types that were added since the last invocation of
+  /// this function are considered, as the others are already
+  /// canonicalized.
   void
   canonicalize_all_types(void)
   {
     canonicalize_types
-      (types_map.begin(), types_map.end(),
-       [](const string_type_base_sptr_map_type::const_iterator& i)
-       {return i->second;});
+      (types_to_canonicalize.begin(), types_to_canonicalize.end(),
+       [](const vector<type_base_sptr>::const_iterator& i)
+       {return *i;});
+    types_to_canonicalize.clear();
   }
 
   /// Constructor.
@@ -246,7 +286,9 @@ public:
   initialize()
   {
     ctfa = nullptr;
+    reset_ctfa_symbol_index();
     types_map.clear();
+    types_to_canonicalize.clear();
     cur_tu_.reset();
     corpus_group().reset();
   }
@@ -336,11 +378,8 @@ public:
     // If it's proccessing a module, then location directory
     // for vmlinux.ctfa should be provided with --debug-info-dir
     // option.
-    for (const auto& path : debug_info_root_paths())
-      if (tools_utils::find_file_under_dir(*path, "vmlinux.ctfa", ctfa_file))
-        return true;
-
-    return false;
+    return elf_helpers::find_file_under_debug_info_roots
+      (debug_info_root_paths(), "vmlinux.ctfa", ctfa_file);
   }
 
   /// Slurp certain information from the underlying ELF file, and
@@ -400,6 +439,144 @@ public:
     status |= fe_iface::STATUS_OK;
   }
 
+  /// Forget about the symbol index of the CTF archive, as well as
+  /// the dictionaries opened through it.
+  ///
+  /// This must be called when the CTF archive changes.
+  void
+  reset_ctfa_symbol_index()
+  {
+    close_ctfa_opened_dicts();
+    ctfa_symbol_index.clear();
+    ctfa_dict_names.clear();
+    ctfa_symbol_index_built = false;
+  }
+
+  /// Close the dictionaries opened to look up symbols through the
+  /// symbol index of the CTF archive.
+  void
+  close_ctfa_opened_dicts()
+  {
+    for (auto& d : ctfa_opened_dicts)
+      ctf_dict_close(d.second);
+    ctfa_opened_dicts.clear();
+  }
+
+  /// Add the symbols described by a given dictionary of the CTF
+  /// archive to the symbol index of the archive.
+  ///
+  /// Symbols already in the index are not modified, so that a symbol
+  /// is associated to the first dictionary that describes it.  In a
+  /// given dictionary, function and data object symbols take
+  /// precedence over variables, just like in
+  /// lookup_symbol_in_ctf_archive.
+  ///
+  /// @param dict the dictionary to consider.
+  ///
+  /// @param dict_index the index of the name of @p dict in
+  /// ctfa_dict_names.
+  void
+  add_dict_symbols_to_ctfa_symbol_index(ctf_dict_t *dict, size_t dict_index)
+  {
+    const char *name = NULL;
+    ctf_id_t type;
+
+    for (int functions = 1; functions >= 0; --functions)
+      {
+	ctf_next_t *i = NULL;
+	while ((type = ctf_symbol_next(dict, &i, &name, functions)) != CTF_ERR)
+	  if (name)
+	    ctfa_symbol_index.emplace(name, ctfa_symbol{dict_index, type});
+      }
+
+    ctf_next_t *i = NULL;
+    while ((type = ctf_variable_next(dict, &i, &name)) != CTF_ERR)
+      if (name)
+	ctfa_symbol_index.emplace(name, ctfa_symbol{dict_index, type});
+  }
+
+  /// Build the index associating the name of the symbols described
+  /// by the CTF archive to the dictionary describing them.
+  ///
+  /// This sweeps the dictionaries of the archive once, in the order
+  /// in which lookup_symbol_in_ctf_archive used to search them.
+  void
+  build_ctfa_symbol_index()
+  {
+    tools_utils::timer t;
+    if (options().do_log)
+      {
+	std::cerr << "building the symbol index of the CTF archive ...";
+	t.start();
+      }
+
+    reset_ctfa_symbol_index();
+
+    int ctf_err;
+    ctf_dict_t *fp;
+    ctf_next_t *i = NULL;
+    const char *arcname;
+    while ((fp = ctf_archive_next(ctfa, &i, &arcname, 1, &ctf_err)) != NULL)
+      {
+	size_t dict_index = ctfa_dict_names.size();
+	ctfa_dict_names.push_back(arcname ? arcname : "");
+	add_dict_symbols_to_ctfa_symbol_index(fp, dict_index);
+	ctf_dict_close(fp);
+      }
+    ctfa_symbol_index_built = true;
+
+    if (options().do_log)
+      {
+	t.stop();
+	std::cerr << " DONE: "
+		  << ctfa_symbol_index.size() << " symbols in "
+		  << ctfa_dict_names.size() << " dictionaries: "
+		  << t << "\n";
+      }
+  }
+
+  /// Look up a symbol in the dictionaries of the CTF archive, using
+  /// the symbol index of the archive.
+  ///
+  /// The index is built the first time this function is invoked.
+  ///
+  /// @param sym_name the name of the symbol to look up.
+  ///
+  /// @param ctf_dict output parameter.  This is set to the dictionary
+  /// that describes @p sym_name, iff the function returns a valid CTF
+  /// type ID.  That dictionary is owned by the reader and must not be
+  /// closed by the caller.
+  ///
+  /// @return the CTF type ID of @p sym_name or CTF_ERR if it's not
+  /// described by the archive.
+  ctf_id_t
+  lookup_symbol_in_ctfa_symbol_index(const char *sym_name,
+				     ctf_dict_t **ctf_dict)
+  {
+    if (!ctfa_symbol_index_built)
+      build_ctfa_symbol_index();
+
+    auto s = ctfa_symbol_index.find(sym_name);
+    if (s == ctfa_symbol_index.end())
+      return CTF_ERR;
+
+    const string& dict_name = ctfa_dict_names[s->second.dict_index];
+    ctf_dict_t*& dict = ctfa_opened_dicts[dict_name];
+    if (!dict)
+      {
+	int ctf_err;
+	dict = ctf_dict_open(ctfa, dict_name.c_str(), &ctf_err);
+	if (!dict)
+	  {
+	    ctfa_opened_dicts.erase(dict_name);
+	    return CTF_ERR;
+	  }
+      }
+
+    *ctf_dict = dict;
+    return s->second.type;
+  }
+
   /// Process a CTF archive and create libabigail IR for the types,
   /// variables and function declarations found in the archive, iterating
   /// over public symbols.  The IR is added to the given corpus.
@@ -415,7 +592,7 @@ public:
     cur_transl_unit(ir_translation_unit);
 
     int ctf_err;
-    ctf_dict_t *ctf_dict, *dict_tmp;
+    ctf_dict_t *ctf_dict;
     const auto symt = symtab();
     symtab_reader::symtab_filter filter = symt->make_filter();
     filter.set_public_symbols();
@@ -441,22 +618,24 @@ public:
 	abort();
       }
 
-    dict_tmp = ctf_dict;
-
     for (const auto& symbol : symtab_reader::filtered_symtab(*symt, filter))
       {
 	std::string sym_name = symbol->get_name();
 	ctf_id_t ctf_sym_type;
 
-	ctf_sym_type = lookup_symbol_in_ctf_archive(ctfa, &ctf_dict,
+	// The symbol might be described by another dictionary of the
+	// archive than the default one.  That dictionary is owned by
+	// ctfa_opened_dicts.
+	ctf_dict_t *sym_dict = ctf_dict;
+	ctf_sym_type = lookup_symbol_in_ctf_archive(this, &sym_dict,
 						    sym_name.c_str());
 	if (ctf_sym_type == CTF_ERR)
           continue;
 
-	if (ctf_type_kind(ctf_dict, ctf_sym_type) != CTF_K_FUNCTION)
+	if (ctf_type_kind(sym_dict, ctf_sym_type) != CTF_K_FUNCTION)
 	  {
 	    const char *var_name = sym_name.c_str();
-	    type_base_sptr var_type = build_type(ctf_dict, ctf_sym_type);
+	    type_base_sptr var_type = build_type(sym_dict, ctf_sym_type);
 	    if (!var_type)
 	      /* Ignore variable if its type can't be sorted out.  */
 	      continue;
@@ -477,7 +656,7 @@ public:
 	  {
 	    const char *func_name = sym_name.c_str();
 	    ctf_id_t ctf_sym = ctf_sym_type;
-	    type_base_sptr func_type = build_type(ctf_dict, ctf_sym);
+	    type_base_sptr func_type = build_type(sym_dict, ctf_sym);
 	    if (!func_type)
 	      /* Ignore function if its type can't be sorted out.  */
 	      continue;
@@ -493,11 +672,10 @@ public:
 	    func_declaration->set_is_in_public_symbol_table(true);
 	    maybe_add_fn_to_exported_decls(func_declaration.get());
 	  }
-
-	ctf_dict = dict_tmp;
       }
 
     ctf_dict_close(ctf_dict);
+    close_ctfa_opened_dicts();
     /* Canonicalize all the types generated above.  This must be
        done "a posteriori" because the processing of types may
        require other related types to not be already
@@ -678,8 +856,11 @@ public:
 	 and process the CTF archive in the read context, if any.
 	 Information about the types, variables, functions, etc contained
 	 in the archive are added to the given corpus.  */
-      ctfa = ctf_arc_bufopen(&ctf_sect, &symtab_sect,
-			     &strtab_sect, &errp);
+      {
+	reset_ctfa_symbol_index();
+	ctfa = ctf_arc_bufopen(&ctf_sect, &symtab_sect,
+			       &strtab_sect, &errp);
+      }
 
     env().canonicalization_is_done(false);
     if (ctfa == NULL)
@@ -699,6 +880,7 @@ public:
   /// Destructor of the CTF reader.
   ~reader()
   {
+    close_ctfa_opened_dicts();
     ctf_close(ctfa);
   }
 }; // end class reader.
@@ -1530,24 +1712,22 @@ process_ctf_enum_type(reader *rdr,
 /// Given a symbol name, lookup the corresponding CTF information in
 /// the default dictionary (CTF archive member provided by the caller)
 /// If the search is not success, the  looks for the symbol name
-/// in _all_ archive members.
+/// in _all_ archive members, using the symbol index of the archive.
 ///
-/// @param ctfa the CTF archive.
+/// @param rdr the CTF reader.
 /// @param dict the default dictionary to looks for.
 /// @param sym_name the symbol name.
-/// @param corp the IR corpus.
 ///
 /// Note that if @ref sym_name is found in other than its default dictionary
-/// @ref ctf_dict will be updated and it must be explicitly closed by its
-/// caller.
+/// @ref ctf_dict will be updated.  That other dictionary is owned by
+/// @p rdr, so it must not be closed by the caller.
 ///
 /// @return a valid CTF type id, if @ref sym_name was found, CTF_ERR otherwise.
 
 static ctf_id_t
-lookup_symbol_in_ctf_archive(ctf_archive_t *ctfa, ctf_dict_t **ctf_dict,
+lookup_symbol_in_ctf_archive(reader *rdr, ctf_dict_t **ctf_dict,
                              const char *sym_name)
 {
-  int ctf_err;
   ctf_dict_t *dict = *ctf_dict;
   ctf_id_t ctf_type = ctf_lookup_by_symbol_name(dict, sym_name);
 
@@ -1560,24 +1740,7 @@ lookup_symbol_in_ctf_archive(ctf_archive_t *ctfa, ctf_dict_t **ctf_dict,
 
   /* Not lucky, then, search in whole archive */
   if (ctf_type == CTF_ERR)
-    {
-      ctf_dict_t *fp;
-      ctf_next_t *i = NULL;
-      const char *arcname;
-
-      while ((fp = ctf_archive_next(ctfa, &i, &arcname, 1, &ctf_err)) != NULL)
-        {
-          if ((ctf_type = ctf_lookup_by_symbol_name (fp, sym_name)) == CTF_ERR)
-            ctf_type = ctf_lookup_variable(fp, sym_name);
-
-          if (ctf_type != CTF_ERR)
-            {
-              *ctf_dict = fp;
-              break;
-            }
-          ctf_dict_close(fp);
-        }
-    }
+    ctf_type = rdr->lookup_symbol_in_ctfa_symbol_index(sym_name, ctf_dict);
 
   return ctf_type;
 }
@@ -52,7 +52,9 @@ default_reporter::diff_has_net_changes(const corpus_diff *d) const
 	  || stats.net_num_removed_func_syms()
 	  || stats.net_num_added_func_syms()
 	  || stats.net_num_removed_var_syms()
-	  || stats.net_num_added_var_syms());
+	  || stats.net_num_added_var_syms()
+	  || stats.num_func_syms_changed()
+	  || stats.num_var_syms_changed());
 }
 
 /// Ouputs a report of the differences between of the two type_decl
@@ -2146,6 +2148,10 @@ default_reporter::report(const corpus_diff& d, ostream& out,
 	out << "\n";
     }
 
+  // Report changed function symbols not referenced by any debug
+  // info.
+  maybe_report_changed_unrefed_symbols(d, /*fn_syms=*/true, indent, out);
+
   // Report removed variable symbols not referenced by any debug info.
   if (ctxt->show_symbols_unreferenced_by_debug_info()
       && d.priv_->deleted_unrefed_var_syms_.size())
@@ -2220,6 +2226,10 @@ default_reporter::report(const corpus_diff& d, ostream& out,
 	out << "\n";
     }
 
+  // Report changed variable symbols not referenced by any debug
+  // info.
+  maybe_report_changed_unrefed_symbols(d, /*fn_syms=*/false, indent, out);
+
   // Report added/removed/changed types not reacheable from public
   // interfaces.
   maybe_report_unreachable_type_changes(d, s, indent, out);
@@ -812,51 +812,6 @@ get_elf_class_size_in_bytes(Elf* elf_handle)
   return result;
 }
 
-/// Get a given word of a bloom filter, referred to by the index of
-/// the word.
-///
-/// The bloom word size depends on the current elf class (32 bits for
-/// an ELFCLASS32 or 64 bits for an ELFCLASS64 one) and this function
-/// abstracts that nicely.
-///
-/// @param elf_handle the elf handle to use.
-///
-/// @param bloom_filter the bloom filter to consider.
-///
-/// @param index the index of the bloom filter to return.
-///
-/// @return a 64 bits work containing the bloom word found at index @p
-/// index.  Note that if we are looking at an ELFCLASS32 binary, the 4
-/// most significant bytes of the result are going to be zero.
-static Elf64_Xword
-bloom_word_at(Elf*		elf_handle,
-	      Elf32_Word*	bloom_filter,
-	      size_t		index)
-{
-  Elf64_Xword result = 0;
-  GElf_Ehdr h;
-  ABG_ASSERT(gelf_getehdr(elf_handle, &h));
-  int c;
-  c = h.e_ident[EI_CLASS];
-
-  switch(c)
-    {
-    case ELFCLASS32:
-      result = bloom_filter[index];
-      break ;
-    case ELFCLASS64:
-      {
-	Elf64_Xword* f= reinterpret_cast<Elf64_Xword*>(bloom_filter);
-	result = f[index];
-      }
-      break;
-    default:
-      abort();
-    }
-
-  return result;
-}
-
 /// The abstraction of the gnu elf hash table.
 ///
 /// The members of this struct are explained at
@@ -875,6 +830,9 @@ struct gnu_ht
   size_t sym_count;
   Elf_Scn* sym_tab_section;
   GElf_Shdr sym_tab_section_header;
+  Elf_Data* sym_tab_data;
+  // The size of the words of the bloom filter, in bytes.
+  char elf_class_size;
 
   gnu_ht()
     : nb_buckets(0),
@@ -886,7 +844,9 @@ struct gnu_ht
       bloom_filter(0),
       shift(0),
       sym_count(0),
-      sym_tab_section(0)
+      sym_tab_section(0),
+      sym_tab_data(0),
+      elf_class_size(0)
   {}
 }; // end struct gnu_ht
 
@@ -914,6 +874,8 @@ setup_gnu_ht(Elf* elf_handle,
   ABG_ASSERT(gelf_getshdr(ht.sym_tab_section, &ht.sym_tab_section_header));
   ht.sym_count =
     ht.sym_tab_section_header.sh_size / ht.sym_tab_section_header.sh_entsize;
+  ht.sym_tab_data = elf_getdata(ht.sym_tab_section, 0);
+  ht.elf_class_size = get_elf_class_size_in_bytes(elf_handle);
   Elf_Scn* hash_section = elf_getscn(elf_handle, ht_index);
   ABG_ASSERT(hash_section);
 
@@ -939,7 +901,7 @@ setup_gnu_ht(Elf* elf_handle,
   // be used to index the 'bloom_filter' above, which is of type
   // Elf32_Word*; thus we need that bf_size be expressed in 4 bytes
   // words.
-  ht.bf_size = (get_elf_class_size_in_bytes(elf_handle) / 4) * ht.bf_nwords;
+  ht.bf_size = (ht.elf_class_size / 4) * ht.bf_nwords;
   // The buckets of the hash table.
   ht.buckets = ht.bloom_filter + ht.bf_size;
   // The chain of the hash table.
@@ -949,23 +911,19 @@ setup_gnu_ht(Elf* elf_handle,
 }
 
 /// Look into the symbol tables of the underlying elf file and find
-/// the symbol we are being asked.
+/// the symbol we are being asked, using a GNU hash table that has
+/// been set up already by setup_gnu_ht.
 ///
-/// This function uses the GNU hash table for the symbol lookup.
+/// This lets several symbols be looked up without setting up the
+/// hash table again for each of them.
 ///
-/// The reference of for the implementation of this function can be
-/// found at:
-///   - https://sourceware.org/ml/binutils/2006-10/msg00377.html
-///   - https://blogs.oracle.com/ali/entry/gnu_hash_elf_sections.
+/// @param env the environment we are operating from.
 ///
 /// @param elf_handle the elf handle to use.
 ///
-/// @param sym_name the name of the symbol to look for.
+/// @param ht the GNU hash table to use.
 ///
-/// @param ht_index the index of the hash table header to use.
-///
-/// @param sym_tab_index the index of the symbol table header to use
-/// with this hash table.
+/// @param sym_name the name of the symbol to look for.
 ///
 /// @param demangle if true, demangle @p sym_name.
 ///
@@ -974,18 +932,13 @@ setup_gnu_ht(Elf* elf_handle,
 ///
 /// @return true if a symbol was actually found.
 static bool
-lookup_symbol_from_gnu_hash_tab(const environment&		env,
-				Elf*				elf_handle,
-				const string&			sym_name,
-				size_t				ht_index,
-				size_t				sym_tab_index,
-				bool				demangle,
-				vector<elf_symbol_sptr>&	syms_found)
+lookup_symbol_from_gnu_ht(const environment&		env,
+			  Elf*				elf_handle,
+			  const gnu_ht&			ht,
+			  const string&			sym_name,
+			  bool				demangle,
+			  vector<elf_symbol_sptr>&	syms_found)
 {
-  gnu_ht ht;
-  if (!setup_gnu_ht(elf_handle, ht_index, sym_tab_index, ht))
-    return false;
-
   // Now do the real work.
 
   // Compute bloom hashes (GNU hash and second bloom specific hashes).
@@ -993,7 +946,7 @@ lookup_symbol_from_gnu_hash_tab(const environment&		env,
   size_t h2 = h1 >> ht.shift;
   // The size of one of the words used in the bloom
   // filter, in bits.
-  int c = get_elf_class_size_in_bytes(elf_handle) * 8;
+  int c = ht.elf_class_size * 8;
   int n =  (h1 / c) % ht.bf_nwords;
   // The bitmask of the bloom filter has a size of either 32-bits on
   // ELFCLASS32 binaries or 64-bits on ELFCLASS64 binaries.  So we
@@ -1003,7 +956,11 @@ lookup_symbol_from_gnu_hash_tab(const environment&		env,
   Elf64_Xword bitmask = (1ul << (h1 % c)) | (1ul << (h2 % c));
 
   // Test if the symbol is *NOT* present in this ELF file.
-  if ((bloom_word_at(elf_handle, ht.bloom_filter, n) & bitmask) != bitmask)
+  Elf64_Xword bloom_word =
+    ht.elf_class_size == 8
+    ? reinterpret_cast<Elf64_Xword*>(ht.bloom_filter)[n]
+    : ht.bloom_filter[n];
+  if ((bloom_word & bitmask) != bitmask)
     return false;
 
   size_t i = ht.buckets[h1 % ht.nb_buckets];
@@ -1036,8 +993,7 @@ lookup_symbol_from_gnu_hash_tab(const environment&		env,
 	// looking for.  Let's keep walking.
 	continue;
 
-      ABG_ASSERT(gelf_getsym(elf_getdata(ht.sym_tab_section, 0),
-			 i, &symbol));
+      ABG_ASSERT(gelf_getsym(ht.sym_tab_data, i, &symbol));
       sym_name_str = elf_strptr(elf_handle,
 				ht.sym_tab_section_header.sh_link,
 				symbol.st_name);
@@ -1077,6 +1033,48 @@ lookup_symbol_from_gnu_hash_tab(const environment&		env,
   return found;
 }
 
+/// Look into the symbol tables of the underlying elf file and find
+/// the symbol we are being asked.
+///
+/// This function uses the GNU hash table for the symbol lookup.
+///
+/// The reference of for the implementation of this function can be
+/// found at:
+///   - https://sourceware.org/ml/binutils/2006-10/msg00377.html
+///   - https://blogs.oracle.com/ali/entry/gnu_hash_elf_sections.
+///
+/// @param elf_handle the elf handle to use.
+///
+/// @param sym_name the name of the symbol to look for.
+///
+/// @param ht_index the index of the hash table header to use.
+///
+/// @param sym_tab_index the index of the symbol table header to use
+/// with this hash table.
+///
+/// @param demangle if true, demangle @p sym_name.
+///
+/// @param syms_found the vector of symbols found with the name @p
+/// sym_name.
+///
+/// @return true if a symbol was actually found.
+static bool
+lookup_symbol_from_gnu_hash_tab(const environment&		env,
+				Elf*				elf_handle,
+				const string&			sym_name,
+				size_t				ht_index,
+				size_t				sym_tab_index,
+				bool				demangle,
+				vector<elf_symbol_sptr>&	syms_found)
+{
+  gnu_ht ht;
+  if (!setup_gnu_ht(elf_handle, ht_index, sym_tab_index, ht))
+    return false;
+
+  return lookup_symbol_from_gnu_ht(env, elf_handle, ht,
+				   sym_name, demangle, syms_found);
+}
+
 /// Look into the symbol tables of the underlying elf file and find
 /// the symbol we are being asked.
 ///
@@ -1138,41 +1136,38 @@ lookup_symbol_from_elf_hash_tab(const environment&		env,
   return false;
 }
 
-/// Lookup a symbol from the symbol table directly.
+/// Lookup a set of symbols from the symbol table directly.
 ///
+/// The symbol table is walked once for all the symbols looked up.
 ///
 /// @param env the environment we are operating from.
 ///
 /// @param elf_handle the elf handle to use.
 ///
-/// @param sym_name the name of the symbol to look up.
+/// @param sym_names the names of the symbols to look up.
 ///
 /// @param sym_tab_index the index (in the section headers table) of
 /// the symbol table section.
 ///
 /// @param demangle if true, demangle the names found in the symbol
-/// table before comparing them with @p sym_name.
-///
-/// @param sym_name_found the actual name of the symbol found.
+/// table before comparing them with @p sym_names.
 ///
-/// @param sym_type the type of the symbol found.
+/// @param syms_found output parameter.  For each element of @p
+/// sym_names, the symbols found with that name are added to the
+/// element of the same index in this vector.  It must have the same
+/// size as @p sym_names.
 ///
-/// @param sym_binding the binding of the symbol found.
-///
-/// @param sym_versions the versions of the symbol found.
-///
-/// @return true iff the symbol was found.
+/// @return true iff at least one symbol was found.
 static bool
-lookup_symbol_from_symtab(const environment&		env,
-			  Elf*				elf_handle,
-			  const string&		sym_name,
-			  size_t			sym_tab_index,
-			  bool				demangle,
-			  vector<elf_symbol_sptr>&	syms_found)
+lookup_symbols_from_symtab(const environment&			env,
+			   Elf*					elf_handle,
+			   const vector<string>&		sym_names,
+			   size_t				sym_tab_index,
+			   bool					demangle,
+			   vector<vector<elf_symbol_sptr>>&	syms_found)
 {
-  // TODO: read all of the symbol table, store it in memory in a data
-  // structure that associates each symbol with its versions and in
-  // which lookups of a given symbol is fast.
+  ABG_ASSERT(syms_found.size() == sym_names.size());
+
   Elf_Scn* sym_tab_section = elf_getscn(elf_handle, sym_tab_index);
   ABG_ASSERT(sym_tab_section);
 
@@ -1180,11 +1175,15 @@ lookup_symbol_from_symtab(const environment&		env,
   GElf_Shdr * sym_tab_header = gelf_getshdr(sym_tab_section,
 					    &header_mem);
 
+  // Associate each name to look up to its indexes in sym_names.
+  std::unordered_map<string, vector<size_t>> names;
+  for (size_t n = 0; n < sym_names.size(); ++n)
+    names[sym_names[n]].push_back(n);
+
   size_t symcount = sym_tab_header->sh_size / sym_tab_header->sh_entsize;
   Elf_Data* symtab = elf_getdata(sym_tab_section, NULL);
   GElf_Sym* sym;
   char* name_str = 0;
-  elf_symbol::version ver;
   bool found = false;
 
   for (size_t i = 0; i < symcount; ++i)
@@ -1194,36 +1193,76 @@ lookup_symbol_from_symtab(const environment&		env,
       name_str = elf_strptr(elf_handle,
 			    sym_tab_header->sh_link,
 			    sym->st_name);
+      if (!name_str)
+	continue;
 
-      if (name_str && compare_symbol_name(name_str, sym_name, demangle))
-	{
-	  elf_symbol::type sym_type =
-	    stt_to_elf_symbol_type(GELF_ST_TYPE(sym->st_info));
-	  elf_symbol::binding sym_binding =
-	    stb_to_elf_symbol_binding(GELF_ST_BIND(sym->st_info));
-	  elf_symbol::visibility sym_visibility =
-	    stv_to_elf_symbol_visibility(GELF_ST_VISIBILITY(sym->st_other));
-	  bool sym_is_defined = sym->st_shndx != SHN_UNDEF;
-	  bool sym_is_common = sym->st_shndx == SHN_COMMON;
+      auto n = names.find(demangle
+			  ? demangle_cplus_mangled_name(name_str)
+			  : string(name_str));
+      if (n == names.end())
+	continue;
 
-	  if (get_version_for_symbol(elf_handle, i,
-				     /*get_def_version=*/sym_is_defined,
-				     ver))
-	    ABG_ASSERT(!ver.str().empty());
-	  elf_symbol_sptr symbol_found =
-	    elf_symbol::create(env, i, sym->st_size,
-			       name_str, sym_type,
-			       sym_binding, sym_is_defined,
-			       sym_is_common, ver, sym_visibility);
-	  syms_found.push_back(symbol_found);
-	  found = true;
-	}
+      elf_symbol::type sym_type =
+	stt_to_elf_symbol_type(GELF_ST_TYPE(sym->st_info));
+      elf_symbol::binding sym_binding =
+	stb_to_elf_symbol_binding(GELF_ST_BIND(sym->st_info));
+      elf_symbol::visibility sym_visibility =
+	stv_to_elf_symbol_visibility(GELF_ST_VISIBILITY(sym->st_other));
+      bool sym_is_defined = sym->st_shndx != SHN_UNDEF;
+      bool sym_is_common = sym->st_shndx == SHN_COMMON;
+
+      elf_symbol::version ver;
+      if (get_version_for_symbol(elf_handle, i,
+				 /*get_def_version=*/sym_is_defined,
+				 ver))
+	ABG_ASSERT(!ver.str().empty());
+      elf_symbol_sptr symbol_found =
+	elf_symbol::create(env, i, sym->st_size,
+			   name_str, sym_type,
+			   sym_binding, sym_is_defined,
+			   sym_is_common, ver, sym_visibility);
+      for (size_t index : n->second)
+	syms_found[index].push_back(symbol_found);
+      found = true;
     }
 
-  if (found)
-    return true;
+  return found;
+}
 
-  return false;
+/// Lookup a symbol from the symbol table directly.
+///
+///
+/// @param env the environment we are operating from.
+///
+/// @param elf_handle the elf handle to use.
+///
+/// @param sym_name the name of the symbol to look up.
+///
+/// @param sym_tab_index the index (in the section headers table) of
+/// the symbol table section.
+///
+/// @param demangle if true, demangle the names found in the symbol
+/// table before comparing them with @p sym_name.
+///
+/// @param syms_found the symbols found with the name @p sym_name.
+///
+/// @return true iff the symbol was found.
+static bool
+lookup_symbol_from_symtab(const environment&		env,
+			  Elf*				elf_handle,
+			  const string&		sym_name,
+			  size_t			sym_tab_index,
+			  bool				demangle,
+			  vector<elf_symbol_sptr>&	syms_found)
+{
+  vector<vector<elf_symbol_sptr>> found(1);
+  if (!lookup_symbols_from_symtab(env, elf_handle,
+				  vector<string>(1, sym_name),
+				  sym_tab_index, demangle, found))
+    return false;
+
+  syms_found.insert(syms_found.end(), found[0].begin(), found[0].end());
+  return true;
 }
 
 /// Look into the symbol tables of the underlying elf file and see
@@ -1291,6 +1330,89 @@ lookup_symbol_from_elf(const environment&		env,
 					 syms_found);
 }
 
+/// Look into the symbol tables of the underlying elf file and see
+/// if we find a set of symbols.
+///
+/// This is what lookup_symbol_from_elf does for each of the symbol
+/// names, but the symbol table and hash table sections are looked up
+/// once, the GNU hash table is set up once, and when there is no hash
+/// table to use, the symbol table is walked once for all the names.
+///
+/// @param env the environment we are operating from.
+///
+/// @param elf_handle the elf handle to use.
+///
+/// @param symbol_names the names of the symbols to look for.
+///
+/// @param demangle if true, try to demangle the symbol names found in
+/// the symbol table before comparing them to @p symbol_names.
+///
+/// @param syms_found output parameter.  This is resized to the size
+/// of @p symbol_names.  Each of its elements is set to the symbols
+/// found with the name of the same index in @p symbol_names.
+///
+/// @return true iff at least one symbol was found.
+static bool
+lookup_symbols_from_elf(const environment&			env,
+			Elf*					elf_handle,
+			const vector<string>&			symbol_names,
+			bool					demangle,
+			vector<vector<elf_symbol_sptr>>&	syms_found)
+{
+  syms_found.clear();
+  syms_found.resize(symbol_names.size());
+
+  size_t hash_table_index = 0, symbol_table_index = 0;
+  hash_table_kind ht_kind = NO_HASH_TABLE_KIND;
+
+  if (!demangle)
+    ht_kind = find_hash_table_section_index(elf_handle,
+					    hash_table_index,
+					    symbol_table_index);
+
+  if (ht_kind == NO_HASH_TABLE_KIND)
+    {
+      if (!find_symbol_table_section_index(elf_handle, symbol_table_index))
+	return false;
+
+      return lookup_symbols_from_symtab(env,
+					elf_handle,
+					symbol_names,
+					symbol_table_index,
+					demangle,
+					syms_found);
+    }
+
+  bool found = false;
+  if (ht_kind == GNU_HASH_TABLE_KIND)
+    {
+      gnu_ht ht;
+      if (!setup_gnu_ht(elf_handle, hash_table_index,
+			symbol_table_index, ht))
+	return false;
+
+      for (size_t i = 0; i < symbol_names.size(); ++i)
+	if (!symbol_names[i].empty()
+	    && lookup_symbol_from_gnu_ht(env, elf_handle, ht,
+					 symbol_names[i], demangle,
+					 syms_found[i]))
+	  found = true;
+    }
+  else
+    for (size_t i = 0; i < symbol_names.size(); ++i)
+      if (lookup_symbol_from_elf_hash_tab(env,
+					  elf_handle,
+					  ht_kind,
+					  hash_table_index,
+					  symbol_table_index,
+					  symbol_names[i],
+					  demangle,
+					  syms_found[i]))
+	found = true;
+
+  return found;
+}
+
 /// Look into the symbol tables of the underlying elf file and see if
 /// we find a given public (global or weak) symbol of function type.
 ///
@@ -1695,6 +1817,33 @@ struct dwarf_expr_eval_context
 // </location expression evaluation types>
 // ---------------------------------------
 
+/// The data that is computed from an alternate debug info file (as
+/// created by the DWZ tool) and that doesn't depend on the binary
+/// that refers to that file.
+///
+/// The binaries of a package usually all refer to the same alternate
+/// debug info file.  So that data is computed only once per
+/// environment, by the first reader that needs it.  It's then shared,
+/// read-only, by all the readers of the environment, including the
+/// readers that run concurrently.
+struct alt_debug_info_data
+{
+  // Protects the building of the data below.  Once is_built is
+  // true, the data is never modified anymore.
+  std::mutex				mutex;
+  bool					is_built = false;
+  // The DIE -> parent map for the DIEs of the alternate debug info
+  // file.
+  offset_offset_map_type		die_parent_map;
+  // The map that associates each tu die of the alternate debug info
+  // file to the vector of unit import points it contains.
+  tu_die_imported_unit_points_map_type	tu_die_imported_unit_points_map;
+}; // end struct alt_debug_info_data
+
+/// Convenience typedef for a shared pointer to @ref
+/// alt_debug_info_data.
+typedef shared_ptr<alt_debug_info_data> alt_debug_info_data_sptr;
+
 class reader;
 
 typedef shared_ptr<reader> reader_sptr;
@@ -1805,6 +1954,30 @@ public:
       alt_debug_info_container_.clear();
       type_unit_container_.clear();
     }
+
+    /// Append the approximate memory usage of the container set to a
+    /// vector.
+    ///
+    /// The containers must be hash tables.
+    ///
+    /// @param name the name of the container set.
+    ///
+    /// @param usage the vector to append the memory usage to.
+    void
+    get_memory_usage(const string& name, memory_usage_vector& usage) const
+    {
+      usage.push_back
+	(memory_usage(name,
+		      primary_debug_info_container_.size()
+		      + alt_debug_info_container_.size()
+		      + type_unit_container_.size(),
+		      get_approximate_hash_table_size
+		      (primary_debug_info_container_)
+		      + get_approximate_hash_table_size
+		      (alt_debug_info_container_)
+		      + get_approximate_hash_table_size
+		      (type_unit_container_)));
+    }
   }; // end die_dependant_container_set
 
   unsigned short		dwarf_version_;
@@ -1822,6 +1995,11 @@ public:
   type_die_repr_die_offsets_maps_;
   mutable die_source_dependant_container_set<die_istring_map_type>
   die_qualified_name_maps_;
+  // A set of maps (one per kind of die source) that associates the
+  // offset of a scope DIE to its qualified name.  That name is the
+  // prefix of the qualified names of the DIEs of that scope.
+  mutable die_source_dependant_container_set<die_istring_map_type>
+  die_scope_name_maps_;
   mutable die_source_dependant_container_set<die_istring_map_type>
   die_pretty_repr_maps_;
   mutable die_source_dependant_container_set<die_istring_map_type>
@@ -1870,13 +2048,11 @@ public:
   // A map that associates each tu die to a vector of unit import
   // points, in the main debug info
   tu_die_imported_unit_points_map_type tu_die_imported_unit_points_map_;
-  // A map that associates each tu die to a vector of unit import
-  // points, in the alternate debug info
-  tu_die_imported_unit_points_map_type alt_tu_die_imported_unit_points_map_;
   tu_die_imported_unit_points_map_type type_units_tu_die_imported_unit_points_map_;
-  // A DIE -> parent map for DIEs coming from the alternate debug info
-  // file.
-  offset_offset_map_type	alternate_die_parent_map_;
+  // The DIE -> parent map and the unit import points of the DIEs
+  // coming from the alternate debug info file.  This is possibly
+  // shared with the other readers of the environment.
+  alt_debug_info_data_sptr	alt_debug_info_data_;
   offset_offset_map_type	type_section_die_parent_map_;
   list<var_decl_sptr>		var_decls_to_add_;
 #ifdef WITH_DEBUG_TYPE_CANONICALIZATION
@@ -1886,6 +2062,11 @@ public:
   mutable size_t		compare_count_;
   mutable size_t		canonical_propagated_count_;
   mutable size_t		cancelled_propagation_count_;
+  // Statistics about the computation of the qualified names of DIEs.
+  mutable size_t		scope_names_computed_count_;
+  mutable size_t		scope_names_reused_count_;
+  mutable size_t		qualified_names_composed_count_;
+  mutable size_t		qualified_names_allocations_count_;
   mutable optional<bool>	leverage_dwarf_factorization_;
 
 protected:
@@ -1955,6 +2136,7 @@ public:
     decl_die_repr_die_offsets_maps_.clear();
     type_die_repr_die_offsets_maps_.clear();
     die_qualified_name_maps_.clear();
+    die_scope_name_maps_.clear();
     die_pretty_repr_maps_.clear();
     die_pretty_type_repr_maps_.clear();
     decl_die_artefact_maps_.clear();
@@ -1976,9 +2158,8 @@ public:
     cur_tu_.reset();
     primary_die_parent_map_.clear();
     tu_die_imported_unit_points_map_.clear();
-    alt_tu_die_imported_unit_points_map_.clear();
     type_units_tu_die_imported_unit_points_map_.clear();
-    alternate_die_parent_map_.clear();
+    alt_debug_info_data_.reset(new alt_debug_info_data);
     type_section_die_parent_map_.clear();
     var_decls_to_add_.clear();
     clear_per_translation_unit_data();
@@ -1992,6 +2173,10 @@ public:
     compare_count_ = 0;
     canonical_propagated_count_ = 0;
     cancelled_propagation_count_ = 0;
+    scope_names_computed_count_ = 0;
+    scope_names_reused_count_ = 0;
+    qualified_names_composed_count_ = 0;
+    qualified_names_allocations_count_ = 0;
     load_in_linux_kernel_mode(linux_kernel_mode);
   }
 
@@ -2057,6 +2242,50 @@ public:
   {
   }
 
+  /// Compute the approximate memory used by the side tables of the
+  /// DWARF reader.
+  ///
+  /// Only the memory of the tables themselves is counted, not the
+  /// memory of the IR artifacts they refer to.
+  ///
+  /// @param usage the vector where to append the memory usage of
+  /// each side table.
+  virtual void
+  get_memory_usage(memory_usage_vector& usage) const
+  {
+    decl_die_repr_die_offsets_maps_.get_memory_usage
+      ("DWARF decl representation -> DIEs maps", usage);
+    type_die_repr_die_offsets_maps_.get_memory_usage
+      ("DWARF type representation -> DIEs maps", usage);
+    die_qualified_name_maps_.get_memory_usage
+      ("DWARF DIE qualified name maps", usage);
+    die_scope_name_maps_.get_memory_usage
+      ("DWARF DIE scope name maps", usage);
+    die_pretty_repr_maps_.get_memory_usage
+      ("DWARF DIE pretty representation maps", usage);
+    die_pretty_type_repr_maps_.get_memory_usage
+      ("DWARF DIE pretty type representation maps", usage);
+    decl_die_artefact_maps_.get_memory_usage
+      ("DWARF decl DIE -> artifact maps", usage);
+    type_die_artefact_maps_.get_memory_usage
+      ("DWARF type DIE -> artifact maps", usage);
+    canonical_type_die_offsets_.get_memory_usage
+      ("DWARF canonical type DIE maps", usage);
+    canonical_decl_die_offsets_.get_memory_usage
+      ("DWARF canonical decl DIE maps", usage);
+    usage.push_back
+      (memory_usage("DWARF DIE comparison results",
+		    die_comparison_results_.size(),
+		    get_approximate_hash_table_size(die_comparison_results_)));
+    usage.push_back
+      (memory_usage("DWARF DIE parent map",
+		    primary_die_parent_map_.size()
+		    + type_section_die_parent_map_.size(),
+		    get_approximate_hash_table_size(primary_die_parent_map_)
+		    + get_approximate_hash_table_size
+		    (type_section_die_parent_map_)));
+  }
+
   /// Read and analyze the ELF and DWARF information associated with
   /// the underlying ELF file and build an ABI corpus out of it.
   ///
@@ -2226,6 +2455,17 @@ public:
 	       << "Number of cancelled propagated canonical types:"
 	       << cancelled_propagation_count_ << "\n";
 	}
+
+      if (show_stats())
+	cerr << "binary: " << elf_path() << "\n"
+	     << "    # scope names computed: "
+	     << scope_names_computed_count_ << "\n"
+	     << "    # scope names reused: "
+	     << scope_names_reused_count_ << "\n"
+	     << "    # qualified names composed: "
+	     << qualified_names_composed_count_ << "\n"
+	     << "    # qualified names string allocations: "
+	     << qualified_names_allocations_count_ << "\n";
     }
 
     {
@@ -2356,6 +2596,7 @@ public:
   clear_per_corpus_data()
   {
     die_qualified_name_maps_.clear();
+    die_scope_name_maps_.clear();
     die_pretty_repr_maps_.clear();
     die_pretty_type_repr_maps_.clear();
     clear_types_to_canonicalize();
@@ -3071,6 +3312,48 @@ public:
       get_die_qualified_name(die, where_offset);
   }
 
+  /// Get the qualified name of a DIE that is the scope of other DIEs.
+  ///
+  /// That name is the prefix of the qualified names of the DIEs of
+  /// the scope.  It's computed only once and then it's retrieved from
+  /// a cache, so that computing the qualified names of the DIEs of a
+  /// scope doesn't walk the chain of the parent scopes again.
+  ///
+  /// Note that this cache is distinct from the one used by
+  /// get_die_qualified_name() and get_die_qualified_type_name() as
+  /// the latter can hold the name of anonymous types in a form that
+  /// is not suitable as a prefix.
+  ///
+  /// @param scope_die the scope DIE to consider.
+  ///
+  /// @param where_offset where in the DIE stream we logically are.
+  ///
+  /// @return the interned string representing the qualified name of
+  /// @p scope_die.
+  interned_string
+  get_die_scope_name(const Dwarf_Die *scope_die, size_t where_offset) const
+  {
+    ABG_ASSERT(scope_die);
+
+    die_istring_map_type& map =
+      die_scope_name_maps_.get_container(*const_cast<reader*>(this),
+					 scope_die);
+
+    size_t die_offset = dwarf_dieoffset(const_cast<Dwarf_Die*>(scope_die));
+    die_istring_map_type::const_iterator i = map.find(die_offset);
+    if (i != map.end())
+      {
+	++scope_names_reused_count_;
+	return i->second;
+      }
+
+    ++scope_names_computed_count_;
+    interned_string istr =
+      env().intern(die_qualified_name(*this, scope_die, where_offset));
+    map[die_offset] = istr;
+    return istr;
+  }
+
   /// Get the qualified name of a given DIE which is considered to be
   /// the DIE for a type.
   ///
@@ -4704,7 +4987,7 @@ public:
       case PRIMARY_DEBUG_INFO_DIE_SOURCE:
 	break;
       case ALT_DEBUG_INFO_DIE_SOURCE:
-	return alt_tu_die_imported_unit_points_map_;
+	return alt_debug_info_data_->tu_die_imported_unit_points_map;
       case TYPE_UNIT_DIE_SOURCE:
 	return type_units_tu_die_imported_unit_points_map_;
       case NO_DEBUG_INFO_DIE_SOURCE:
@@ -4746,7 +5029,7 @@ public:
       case PRIMARY_DEBUG_INFO_DIE_SOURCE:
 	break;
       case ALT_DEBUG_INFO_DIE_SOURCE:
-	return alternate_die_parent_map_;
+	return alt_debug_info_data_->die_parent_map;
       case TYPE_UNIT_DIE_SOURCE:
 	return type_section_die_parent_map();
       case NO_DEBUG_INFO_DIE_SOURCE:
@@ -5295,6 +5578,30 @@ public:
     return true;
   }
 
+  /// Get the data derived from the alternate debug info file of the
+  /// current binary.
+  ///
+  /// As that data doesn't depend on the current binary, it's shared
+  /// by all the live readers of the environment that read binaries
+  /// referring to the same alternate debug info file.  That file is
+  /// identified by its build-id.  The data is freed when the last of
+  /// these readers is destroyed or re-initialized.
+  ///
+  /// @return the data derived from the alternate debug info file.
+  /// If the current binary has no alternate debug info file, or if
+  /// its build-id is unknown, then a data object that is private to
+  /// the current reader is returned.
+  alt_debug_info_data_sptr
+  get_alt_debug_info_data()
+  {
+    const string& build_id = alternate_dwarf_debug_info_build_id();
+    if (!alternate_dwarf_debug_info() || build_id.empty())
+      return alt_debug_info_data_;
+
+    return env().priv_->get_or_create_shared_front_end_data
+      <alt_debug_info_data>("dwarf-reader/alt-debug-info/" + build_id);
+  }
+
   /// Walk all the DIEs accessible in the debug info (and in the
   /// alternate debug info as well) and build maps representing the
   /// relationship DIE -> parent.  That is, make it so that we can get
@@ -5345,26 +5652,42 @@ public:
       return;
 
     // Build the DIE -> parent relation for DIEs coming from the
-    // .debug_info section in the alternate debug info file.
+    // .debug_info section in the alternate debug info file.  That is
+    // done only once per alternate debug info file in the
+    // environment.
     die_source source = ALT_DEBUG_INFO_DIE_SOURCE;
-    for (Dwarf_Off offset = 0, next_offset = 0;
-	 (dwarf_next_unit(const_cast<Dwarf*>(alternate_dwarf_debug_info()),
-			  offset, &next_offset, &header_size,
-			  NULL, NULL, &address_size, NULL, NULL, NULL) == 0);
-	 offset = next_offset)
-      {
-	Dwarf_Off die_offset = offset + header_size;
-	Dwarf_Die cu;
-	if (!dwarf_offdie(const_cast<Dwarf*>(alternate_dwarf_debug_info()),
-			  die_offset, &cu))
-	  continue;
-	cur_tu_die(&cu);
+    alt_debug_info_data_ = get_alt_debug_info_data();
+    {
+      std::lock_guard<std::mutex> lock(alt_debug_info_data_->mutex);
+      if (!alt_debug_info_data_->is_built)
+	{
+	  for (Dwarf_Off offset = 0, next_offset = 0;
+	       (dwarf_next_unit(const_cast<Dwarf*>
+				(alternate_dwarf_debug_info()),
+				offset, &next_offset, &header_size,
+				NULL, NULL, &address_size,
+				NULL, NULL, NULL) == 0);
+	       offset = next_offset)
+	    {
+	      Dwarf_Off die_offset = offset + header_size;
+	      Dwarf_Die cu;
+	      if (!dwarf_offdie(const_cast<Dwarf*>
+				(alternate_dwarf_debug_info()),
+				die_offset, &cu))
+		continue;
+	      cur_tu_die(&cu);
 
-	imported_unit_points_type& imported_units =
-	  tu_die_imported_unit_points_map(source)[die_offset] =
-	  imported_unit_points_type();
-	build_die_parent_relations_under(&cu, source, imported_units);
-      }
+	      imported_unit_points_type& imported_units =
+		tu_die_imported_unit_points_map(source)[die_offset] =
+		imported_unit_points_type();
+	      build_die_parent_relations_under(&cu, source, imported_units);
+	    }
+	  alt_debug_info_data_->is_built = true;
+	}
+      else if (do_log())
+	cerr << "reusing the DIE -> parent map of alternate debug info file '"
+	     << alternate_dwarf_debug_info_path() << "'\n";
+    }
 
     // Build the DIE -> parent relation for DIEs coming from the
     // .debug_info section of the main debug info file.
@@ -9131,6 +9454,54 @@ get_internal_anonymous_die_name(Dwarf_Die *die,
 // <DIE pretty printer>
 // ------------------------------------
 
+/// Compose the qualified name of a DIE from the qualified name of
+/// its scope and from its local name.
+///
+/// The resulting string is allocated at most once, with its final
+/// size, rather than being built by concatenating temporary strings.
+///
+/// @param rdr the DWARF reader.  Its statistics about the
+/// composition of qualified names are updated.
+///
+/// @param scope_name the qualified name of the scope of the DIE.
+///
+/// @param separator the string to put between @p scope_name and @p
+/// name.
+///
+/// @param name the local name of the DIE.
+///
+/// @param result output parameter.  This is set to the resulting
+/// qualified name.
+static void
+compose_qualified_name(const reader&		rdr,
+		       const interned_string&	scope_name,
+		       const char*		separator,
+		       const string&		name,
+		       string&			result)
+{
+  ++rdr.qualified_names_composed_count_;
+
+  const string* scope = scope_name.raw();
+  bool has_scope = scope && !scope->empty();
+
+  size_t len = name.size();
+  if (has_scope)
+    len += scope->size() + strlen(separator);
+
+  size_t capacity = result.capacity();
+  result.clear();
+  result.reserve(len);
+  if (result.capacity() != capacity)
+    ++rdr.qualified_names_allocations_count_;
+
+  if (has_scope)
+    {
+      result.append(*scope);
+      result.append(separator);
+    }
+  result.append(name);
+}
+
 /// Compute the qualified name of a DIE that represents a type.
 ///
 /// For instance, if the DIE tag is DW_TAG_subprogram then this
@@ -9164,10 +9535,6 @@ die_qualified_type_name(const reader& rdr,
   if (!get_scope_die(rdr, die, where_offset, scope_die))
     return "";
 
-  string parent_name = die_qualified_name(rdr, &scope_die, where_offset);
-  bool colon_colon = die_is_type(die) || die_is_namespace(die);
-  string separator = colon_colon ? "::" : ".";
-
   string repr;
 
   switch (tag)
@@ -9200,7 +9567,12 @@ die_qualified_type_name(const reader& rdr,
 	  name = get_internal_anonymous_die_prefix_name(die);
 
 	ABG_ASSERT(!name.empty());
-	repr = parent_name.empty() ? name : parent_name + separator + name;
+	bool colon_colon = die_is_type(die) || die_is_namespace(die);
+	compose_qualified_name(rdr,
+			       rdr.get_die_scope_name(&scope_die,
+						      where_offset),
+			       colon_colon ? "::" : ".",
+			       name, repr);
       }
       break;
 
@@ -9423,9 +9795,6 @@ die_qualified_decl_name(const reader& rdr,
   if (!get_scope_die(rdr, die, where_offset, scope_die))
     return "";
 
-  string scope_name = die_qualified_name(rdr, &scope_die, where_offset);
-  string separator = "::";
-
   string repr;
 
   int tag = dwarf_tag(const_cast<Dwarf_Die*>(die));
@@ -9434,7 +9803,9 @@ die_qualified_decl_name(const reader& rdr,
     case DW_TAG_namespace:
     case DW_TAG_member:
     case DW_TAG_variable:
-      repr = scope_name.empty() ? name : scope_name + separator + name;
+      compose_qualified_name(rdr,
+			     rdr.get_die_scope_name(&scope_die, where_offset),
+			     "::", name, repr);
       break;
     case DW_TAG_subprogram:
       repr = die_function_signature(rdr, die, where_offset);
@@ -16254,6 +16625,56 @@ lookup_symbol_from_elf(const environment&		env,
   return value;
 }
 
+/// Look into the symbol tables of a given elf file and see if we find
+/// a set of symbols.
+///
+/// This is more efficient than invoking lookup_symbol_from_elf for
+/// each symbol, as the ELF file is opened once and the symbol lookup
+/// tables are set up once for all the symbols.
+///
+/// @param env the environment we are operating from.
+///
+/// @param elf_path the path to the elf file to consider.
+///
+/// @param symbol_names the names of the symbols to look for.
+///
+/// @param demangle if true, try to demangle the symbol names found in
+/// the symbol table.
+///
+/// @param syms output parameter.  This is resized to the size of @p
+/// symbol_names.  Each of its elements is set to the symbols found
+/// with the name of the same index in @p symbol_names.
+///
+/// @return true iff at least one of the symbols was found.
+bool
+lookup_symbols_from_elf(const environment&			env,
+			const string&				elf_path,
+			const vector<string>&			symbol_names,
+			bool					demangle,
+			vector<vector<elf_symbol_sptr>>&	syms)
+{
+  if (elf_version(EV_CURRENT) == EV_NONE)
+    return false;
+
+  int fd = open(elf_path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  Elf* elf = elf_begin(fd, ELF_C_READ, 0);
+  if (elf == 0)
+    {
+      close(fd);
+      return false;
+    }
+
+  bool value = lookup_symbols_from_elf(env, elf, symbol_names,
+				       demangle, syms);
+  elf_end(elf);
+  close(fd);
+
+  return value;
+}
+
 /// Look into the symbol tables of an elf file to see if a public
 /// function of a given name is found.
 ///
@@ -11,11 +11,22 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <limits.h>
+#include <fts.h>
 #include <elfutils/libdwfl.h>
+#include <cstring>
+#include <fstream>
+#include <mutex>
 #include <sstream>
-#include "abg-elf-helpers.h"
+#include <unordered_map>
+#include "abg-internal.h"
 #include "abg-tools-utils.h"
 
+// Though this is an internal header, we need to export the symbols to be able
+// to test this code.
+ABG_BEGIN_EXPORT_DECLARATIONS
+#include "abg-elf-helpers.h"
+ABG_END_EXPORT_DECLARATIONS
+
 namespace abigail
 {
 
@@ -388,6 +399,67 @@ find_section(Elf* elf_handle, Elf64_Word section_type)
   return section;
 }
 
+/// Compute the size that the compressed debug info sections of an
+/// ELF file have once decompressed.
+///
+/// Both the SHF_COMPRESSED sections and the legacy .zdebug_*
+/// sections are considered.  Note that this needs to be invoked
+/// before the sections are decompressed by libdw, as that clears
+/// their SHF_COMPRESSED flag.
+///
+/// @param elf_handle the elf handle to use.
+///
+/// @return the decompressed size of the compressed debug sections
+/// of @p elf_handle.
+uint64_t
+get_decompressed_size_of_debug_sections(Elf* elf_handle)
+{
+  size_t section_header_string_index = 0;
+  if (elf_getshdrstrndx (elf_handle, &section_header_string_index) < 0)
+    return 0;
+
+  uint64_t result = 0;
+  Elf_Scn* section = 0;
+  GElf_Shdr header_mem, *header;
+  while ((section = elf_nextscn(elf_handle, section)) != 0)
+    {
+      header = gelf_getshdr(section, &header_mem);
+      if (header == NULL || header->sh_type == SHT_NOBITS)
+	continue;
+
+      const char* section_name =
+	elf_strptr(elf_handle, section_header_string_index, header->sh_name);
+      if (!section_name)
+	continue;
+
+      if (header->sh_flags & SHF_COMPRESSED)
+	{
+	  GElf_Chdr compression_header;
+	  if (strncmp(section_name, ".debug_", 7) == 0
+	      && gelf_getchdr(section, &compression_header))
+	    result += compression_header.ch_size;
+	}
+      else if (strncmp(section_name, ".zdebug_", 8) == 0)
+	{
+	  // The data of these sections starts with the "ZLIB" magic
+	  // number followed by the decompressed size, as a 64 bits
+	  // big endian number.
+	  Elf_Data* data = elf_rawdata(section, NULL);
+	  if (data == NULL || data->d_size < 12
+	      || memcmp(data->d_buf, "ZLIB", 4) != 0)
+	    continue;
+	  const unsigned char* size =
+	    reinterpret_cast<const unsigned char*>(data->d_buf) + 4;
+	  uint64_t decompressed_size = 0;
+	  for (int i = 0; i < 8; ++i)
+	    decompressed_size = (decompressed_size << 8) | size[i];
+	  result += decompressed_size;
+	}
+    }
+
+  return result;
+}
+
 /// Find and return the .symtab section
 ///
 /// @param elf_handle the elf handle to use.
@@ -920,38 +992,90 @@ get_version_for_symbol(Elf*			elf_handle,
 bool
 get_crc_for_symbol(Elf* elf_handle, GElf_Sym* crc_symbol, uint32_t& crc_value)
 {
-  size_t crc_section_index = crc_symbol->st_shndx;
-  GElf_Addr crc_symbol_address =
-      maybe_adjust_et_rel_sym_addr_to_abs_addr(elf_handle, crc_symbol);
-  if (crc_section_index == SHN_ABS)
-    {
-      crc_value = crc_symbol_address;
-      return true;
-    }
+  std::vector<uint32_t> crc_values;
+  if (!get_crcs_for_symbols(elf_handle,
+			    std::vector<GElf_Sym>(1, *crc_symbol),
+			    crc_values))
+    return false;
+  crc_value = crc_values[0];
+  return true;
+}
 
-  Elf_Scn* kcrctab_section = elf_getscn(elf_handle, crc_section_index);
-  if (kcrctab_section == NULL)
-      return false;
+/// Return the CRCs from a set of "__crc_" symbols.
+///
+/// This does what get_crc_for_symbol does for each symbol, but the
+/// header and the data of each __kcrctab section are fetched once,
+/// rather than once per symbol.
+///
+/// @param elf_handle the elf handle to use.
+///
+/// @param crc_symbols the symbols containing the CRC values.
+///
+/// @param crc_values output parameter.  This is set to the CRC
+/// values of the symbols of @p crc_symbols, in the same order.
+///
+/// @return true iff a CRC was found for all the symbols of @p
+/// crc_symbols.
+bool
+get_crcs_for_symbols(Elf*				elf_handle,
+		     const std::vector<GElf_Sym>&	crc_symbols,
+		     std::vector<uint32_t>&		crc_values)
+{
+  crc_values.resize(crc_symbols.size());
 
-  GElf_Shdr sheader_mem;
-  GElf_Shdr* sheader = gelf_getshdr(kcrctab_section, &sheader_mem);
-  if (sheader == NULL)
-    return false;
+  GElf_Ehdr elf_header;
+  bool is_relocatable =
+    gelf_getehdr(elf_handle, &elf_header) && elf_header.e_type == ET_REL;
+
+  // The header and the raw data of the sections the CRC symbols refer
+  // to, by section index.
+  struct crc_section
+  {
+    GElf_Shdr header;
+    Elf_Data* data;
+  };
+  std::unordered_map<size_t, crc_section> sections;
+
+  for (size_t i = 0; i < crc_symbols.size(); ++i)
+    {
+      const GElf_Sym& crc_symbol = crc_symbols[i];
+      size_t crc_section_index = crc_symbol.st_shndx;
+      if (crc_section_index == SHN_ABS)
+	{
+	  crc_values[i] = crc_symbol.st_value;
+	  continue;
+	}
 
-  Elf_Data* kcrctab_data = elf_rawdata(kcrctab_section, NULL);
-  if (kcrctab_data == NULL)
-    return false;
+      auto s = sections.find(crc_section_index);
+      if (s == sections.end())
+	{
+	  crc_section section;
+	  Elf_Scn* kcrctab_section = elf_getscn(elf_handle, crc_section_index);
+	  if (kcrctab_section == NULL
+	      || gelf_getshdr(kcrctab_section, &section.header) == NULL
+	      || (section.data = elf_rawdata(kcrctab_section, NULL)) == NULL)
+	    return false;
+	  s = sections.emplace(crc_section_index, section).first;
+	}
+      const GElf_Shdr& sheader = s->second.header;
+      const Elf_Data* kcrctab_data = s->second.data;
 
-  if (crc_symbol_address < sheader->sh_addr)
-    return false;
+      GElf_Addr crc_symbol_address = crc_symbol.st_value;
+      if (is_relocatable)
+	crc_symbol_address += sheader.sh_addr;
 
-  size_t offset = crc_symbol_address - sheader->sh_addr;
-  if (offset + sizeof(uint32_t) > kcrctab_data->d_size
-      || offset + sizeof(uint32_t) > sheader->sh_size)
-    return false;
+      if (crc_symbol_address < sheader.sh_addr)
+	return false;
+
+      size_t offset = crc_symbol_address - sheader.sh_addr;
+      if (offset + sizeof(uint32_t) > kcrctab_data->d_size
+	  || offset + sizeof(uint32_t) > sheader.sh_size)
+	return false;
 
-  crc_value = *reinterpret_cast<uint32_t*>(
-      reinterpret_cast<char*>(kcrctab_data->d_buf) + offset);
+      memcpy(&crc_values[i],
+	     reinterpret_cast<const char*>(kcrctab_data->d_buf) + offset,
+	     sizeof(uint32_t));
+    }
 
   return true;
 }
@@ -1473,7 +1597,7 @@ const Dwfl_Callbacks&
 initialize_dwfl_callbacks(Dwfl_Callbacks& cb,
 			  char** debug_info_root_path)
 {
-  cb.find_debuginfo = dwfl_standard_find_debuginfo;
+  cb.find_debuginfo = find_debuginfo_from_root_indexes;
   cb.section_address = dwfl_offline_section_address;
   cb.debuginfo_path = debug_info_root_path;
   return cb;
@@ -1486,6 +1610,597 @@ create_new_dwfl_handle(Dwfl_Callbacks& cb)
   return handle;
 }
 
+/// The private data of the @ref debug_info_root_index type.
+struct debug_info_root_index::priv
+{
+  // The root directory, with a trailing '/'.
+  string			root_dir;
+  // The paths of the files found under root_dir, relative to it, in
+  // the order in which the directory tree was walked.
+  vector<string>		files;
+  // The paths of the directories found under root_dir, relative to
+  // it, with their time of last modification.  This is used to tell
+  // if the index, or a cache file of it, is still up to date.
+  vector<std::pair<string, struct timespec> >	dirs;
+  // A map which key is a relative path and which value is an index
+  // into the files vector.
+  unordered_map<string, size_t>	relative_path_map;
+  // A map which key is a file name and which value is the index of
+  // the first file with that name, into the files vector.
+  unordered_map<string, size_t>	file_name_map;
+  // A map which key is a build ID (followed by the suffix of the
+  // file, e.g, ".debug") and which value is an index into the files
+  // vector.  This is built from the .build-id/ sub-directories.
+  unordered_map<string, size_t>	build_id_map;
+
+  priv(const string& root)
+    : root_dir(root)
+  {
+    if (!tools_utils::string_ends_with(root_dir, "/"))
+      root_dir += "/";
+  }
+
+  /// Add a file to the index.
+  ///
+  /// @param relative_path the path of the file, relative to the root
+  /// directory.
+  ///
+  /// @param is_symlink true iff the file is a symbolic link.  Just
+  /// like for tools_utils::find_file_under_dir(), symbolic links can
+  /// only be looked up by build ID.
+  void
+  add_file(const string& relative_path, bool is_symlink)
+  {
+    size_t i = files.size();
+    files.push_back(relative_path);
+
+    if (!is_symlink)
+      {
+	relative_path_map.emplace(relative_path, i);
+	string::size_type slash = relative_path.rfind('/');
+	file_name_map.emplace(slash == string::npos
+			      ? relative_path
+			      : relative_path.substr(slash + 1),
+			      i);
+      }
+
+    // Files under .build-id/ are named like NN/NNNNNN[.debug], where
+    // NNNNNNNN is the build ID of the binary.
+    static const string build_id_dir = ".build-id/";
+    string::size_type pos = relative_path.find(build_id_dir);
+    if (pos != string::npos
+	&& (pos == 0 || relative_path[pos - 1] == '/'))
+      {
+	string key = relative_path.substr(pos + build_id_dir.size());
+	if (key.size() > 3 && key[2] == '/')
+	  build_id_map.emplace(key.substr(0, 2) + key.substr(3), i);
+      }
+  }
+
+  /// Clear the content of the index.
+  void
+  clear()
+  {
+    files.clear();
+    dirs.clear();
+    relative_path_map.clear();
+    file_name_map.clear();
+    build_id_map.clear();
+  }
+}; // end struct debug_info_root_index::priv
+
+/// Constructor of @ref debug_info_root_index.
+///
+/// Note that the index is empty until either @ref build() or @ref
+/// load() is called.
+///
+/// @param root_dir the root directory to index.
+debug_info_root_index::debug_info_root_index(const string& root_dir)
+  : priv_(new priv(root_dir))
+{}
+
+debug_info_root_index::~debug_info_root_index() = default;
+
+/// Getter of the root directory indexed, with a trailing '/'.
+///
+/// @return the root directory indexed.
+const string&
+debug_info_root_index::root_dir() const
+{return priv_->root_dir;}
+
+/// Getter of the number of files in the index.
+///
+/// @return the number of files in the index.
+size_t
+debug_info_root_index::size() const
+{return priv_->files.size();}
+
+/// Build the index by walking the directory tree under the root
+/// directory.
+void
+debug_info_root_index::build()
+{
+  priv_->clear();
+
+  char* paths[] = {const_cast<char*>(priv_->root_dir.c_str()), 0};
+  FTS *file_hierarchy = fts_open(paths,
+				 FTS_PHYSICAL|FTS_NOCHDIR|FTS_XDEV, 0);
+  if (!file_hierarchy)
+    return;
+
+  FTSENT *entry;
+  while ((entry = fts_read(file_hierarchy)))
+    {
+      string path = tools_utils::trim_leading_string(entry->fts_path,
+						     priv_->root_dir);
+      switch (entry->fts_info)
+	{
+	case FTS_D:
+	  priv_->dirs.push_back(std::make_pair(path,
+					       entry->fts_statp->st_mtim));
+	  break;
+	case FTS_F:
+	  priv_->add_file(path, /*is_symlink=*/false);
+	  break;
+	case FTS_SL:
+	  priv_->add_file(path, /*is_symlink=*/true);
+	  break;
+	default:
+	  break;
+	}
+    }
+
+  fts_close(file_hierarchy);
+}
+
+/// Test if the index is up to date with respect to the directory
+/// tree it was built from.
+///
+/// As adding, removing or renaming an entry of a directory updates
+/// its time of last modification, the index is up to date iff none
+/// of the directories it was built from has been modified since it
+/// was built.
+///
+/// An index that has no directory was built from a root directory
+/// that didn't exist.  It is up to date for as long as the root
+/// directory doesn't exist.
+///
+/// Note that this looks at every directory of the index, so it must
+/// not be called for each lookup.
+///
+/// @return true iff the index is up to date.
+bool
+debug_info_root_index::is_up_to_date() const
+{
+  struct stat st;
+  if (priv_->dirs.empty())
+    return stat(priv_->root_dir.c_str(), &st) != 0;
+
+  for (const auto& d : priv_->dirs)
+    if (stat((priv_->root_dir + d.first).c_str(), &st)
+	|| !S_ISDIR(st.st_mode)
+	|| st.st_mtim.tv_sec != d.second.tv_sec
+	|| st.st_mtim.tv_nsec != d.second.tv_nsec)
+      return false;
+  return true;
+}
+
+/// The first line of the cache files of @ref debug_info_root_index.
+static const char* debug_info_root_index_magic =
+  "abigail-debug-info-root-index 2";
+
+/// Write a string to a cache file of @ref debug_info_root_index.
+///
+/// The string is prefixed by its length so that it can contain any
+/// character, including new lines.
+///
+/// @param out the stream to write to.
+///
+/// @param str the string to write.
+static void
+write_length_prefixed_string(std::ostream& out, const string& str)
+{out << str.size() << " " << str << "\n";}
+
+/// Read a string written by write_length_prefixed_string().
+///
+/// @param in the stream to read from.
+///
+/// @param str output parameter.  This is set to the string read.
+///
+/// @return true iff the string could be read.
+static bool
+read_length_prefixed_string(std::istream& in, string& str)
+{
+  size_t len = 0;
+  if (!(in >> len) || in.get() != ' ')
+    return false;
+  str.resize(len);
+  if (len && !in.read(&str[0], len))
+    return false;
+  return in.get() == '\n';
+}
+
+/// Load the index from a cache file saved by @ref save().
+///
+/// The cache file is considered out of date if any of the directories
+/// it was built from has been modified since then.  In that case, the
+/// index is left empty.
+///
+/// @param cache_path the path to the cache file.
+///
+/// @return true iff the index was loaded and is up to date.
+bool
+debug_info_root_index::load(const string& cache_path)
+{
+  priv_->clear();
+
+  std::ifstream in(cache_path.c_str(), std::ios::binary);
+  if (!in)
+    return false;
+
+  string line, root_dir;
+  if (!std::getline(in, line) || line != debug_info_root_index_magic
+      || !read_length_prefixed_string(in, root_dir)
+      || root_dir != priv_->root_dir)
+    return false;
+
+  char kind = 0;
+  while (in.get(kind))
+    {
+      string path;
+      struct timespec mtime = {};
+      bool ok = in.get() == ' ';
+      if (ok && kind == 'd')
+	ok = (in >> mtime.tv_sec >> mtime.tv_nsec) && in.get() == ' ';
+      ok = ok && read_length_prefixed_string(in, path);
+      if (!ok)
+	{
+	  priv_->clear();
+	  return false;
+	}
+
+      switch (kind)
+	{
+	case 'd':
+	  priv_->dirs.push_back(std::make_pair(path, mtime));
+	  break;
+	case 'f':
+	  priv_->add_file(path, /*is_symlink=*/false);
+	  break;
+	case 's':
+	  priv_->add_file(path, /*is_symlink=*/true);
+	  break;
+	default:
+	  priv_->clear();
+	  return false;
+	}
+    }
+
+  if (!is_up_to_date())
+    {
+      priv_->clear();
+      return false;
+    }
+  return true;
+}
+
+/// Save the index into a cache file.
+///
+/// The file is first written under a temporary name and then renamed,
+/// so that concurrent readers never see a partially written file.
+///
+/// @param cache_path the path to the cache file.
+///
+/// @return true iff the index could be saved.
+bool
+debug_info_root_index::save(const string& cache_path) const
+{
+  string tmp_path = cache_path + "-XXXXXX";
+  int fd = mkstemp(const_cast<char*>(tmp_path.c_str()));
+  if (fd == -1)
+    return false;
+  close(fd);
+
+  {
+    std::ofstream out(tmp_path.c_str(), std::ios::binary);
+    out << debug_info_root_index_magic << "\n";
+    write_length_prefixed_string(out, priv_->root_dir);
+
+    for (const auto& d : priv_->dirs)
+      {
+	out << "d " << d.second.tv_sec << " " << d.second.tv_nsec << " ";
+	write_length_prefixed_string(out, d.first);
+      }
+
+    for (size_t i = 0; i < priv_->files.size(); ++i)
+      {
+	const string& f = priv_->files[i];
+	bool is_symlink =
+	  priv_->relative_path_map.find(f) == priv_->relative_path_map.end();
+	out << (is_symlink ? "s " : "f ");
+	write_length_prefixed_string(out, f);
+      }
+
+    if (!out)
+      {
+	unlink(tmp_path.c_str());
+	return false;
+      }
+  }
+
+  if (rename(tmp_path.c_str(), cache_path.c_str()))
+    {
+      unlink(tmp_path.c_str());
+      return false;
+    }
+  return true;
+}
+
+/// Find a file in the index.
+///
+/// This has the same semantics as tools_utils::find_file_under_dir():
+/// the file is found if its relative path or its name equals the one
+/// looked for.
+///
+/// @param file_path_to_look_for the file to look for.
+///
+/// @param result the resulting absolute path to the file.  This is
+/// set iff the file has been found.
+///
+/// @return true iff the file has been found.
+bool
+debug_info_root_index::find_file(const string& file_path_to_look_for,
+				 string& result) const
+{
+  auto i = priv_->relative_path_map.find(file_path_to_look_for);
+  if (i == priv_->relative_path_map.end())
+    {
+      i = priv_->file_name_map.find(file_path_to_look_for);
+      if (i == priv_->file_name_map.end())
+	return false;
+    }
+
+  result = priv_->root_dir + priv_->files[i->second];
+  return true;
+}
+
+/// Find a file by build ID in the index.
+///
+/// @param build_id the build ID, as an hexadecimal string.
+///
+/// @param suffix the suffix of the file to look for under the
+/// .build-id/ directory.  It's ".debug" for split debug info files
+/// and the empty string for alternate DWZ debug info files.
+///
+/// @param result the resulting absolute path to the file.  This is
+/// set iff the file has been found.
+///
+/// @return true iff the file has been found.
+bool
+debug_info_root_index::find_file_by_build_id(const string&	build_id,
+					     const string&	suffix,
+					     string&		result) const
+{
+  auto i = priv_->build_id_map.find(build_id + suffix);
+  if (i == priv_->build_id_map.end())
+    return false;
+
+  result = priv_->root_dir + priv_->files[i->second];
+  return true;
+}
+
+/// Get the path to the cache file of the index of a given root
+/// directory.
+///
+/// Cache files are only used if the environment variable
+/// LIBABIGAIL_DEBUG_INFO_INDEX_CACHE_DIR is set to the directory where
+/// to store them.
+///
+/// @param root_dir the root directory to consider.
+///
+/// @return the path to the cache file, or the empty string if no
+/// cache file is to be used.
+static string
+get_debug_info_root_index_cache_path(const string& root_dir)
+{
+  const char* cache_dir = getenv("LIBABIGAIL_DEBUG_INFO_INDEX_CACHE_DIR");
+  if (!cache_dir || !*cache_dir)
+    return "";
+
+  char* real_root = realpath(root_dir.c_str(), nullptr);
+  if (!real_root)
+    return "";
+  string root = real_root;
+  free(real_root);
+
+  if (!tools_utils::ensure_dir_path_created(cache_dir))
+    return "";
+
+  std::ostringstream o;
+  o << cache_dir << "/debug-info-index-"
+    << std::hex << std::hash<string>()(root);
+  return o.str();
+}
+
+/// Get the index of the files under a given debug info root
+/// directory.
+///
+/// The index is built the first time it's requested and is then
+/// shared by all the readers of the process.  If a cache directory
+/// was specified using the environment variable
+/// LIBABIGAIL_DEBUG_INFO_INDEX_CACHE_DIR, the index is loaded from
+/// there if it's up to date, or saved there after being built.
+///
+/// This function is thread safe.
+///
+/// @param root_dir the root directory to consider.
+///
+/// @param revalidate if true and if the index was built already,
+/// check that the directory tree it was built from hasn't been
+/// modified since then, and rebuild it if it has.  This is costly,
+/// so it should be done once per reader, rather than once per
+/// lookup.  See @ref revalidate_debug_info_root_indexes.
+///
+/// @return the index of @p root_dir.
+debug_info_root_index_sptr
+get_debug_info_root_index(const string& root_dir, bool revalidate)
+{
+  static std::mutex indexes_mutex;
+  static unordered_map<string, debug_info_root_index_sptr> indexes;
+
+  {
+    std::lock_guard<std::mutex> lock(indexes_mutex);
+    auto i = indexes.find(root_dir);
+    if (i != indexes.end())
+      {
+	if (!revalidate || i->second->is_up_to_date())
+	  return i->second;
+	indexes.erase(i);
+      }
+  }
+
+  // Build the index without holding the lock so that indexes of
+  // different roots can be built concurrently.
+  debug_info_root_index_sptr index(new debug_info_root_index(root_dir));
+  string cache_path = get_debug_info_root_index_cache_path(root_dir);
+  if (cache_path.empty() || !index->load(cache_path))
+    {
+      index->build();
+      if (!cache_path.empty())
+	index->save(cache_path);
+    }
+
+  // If another thread built the index of the same root directory in
+  // the mean time, use that one.
+  std::lock_guard<std::mutex> lock(indexes_mutex);
+  return indexes.emplace(root_dir, index).first->second;
+}
+
+/// Make sure the indexes of a set of debug info root directories are
+/// up to date.
+///
+/// The directories might have been modified, or removed and
+/// re-created, since their indexes were built; e.g, when packages are
+/// extracted into re-used temporary directories.  This is meant to
+/// be called once when a reader is initialized, so that the lookups
+/// it then performs don't have to check the indexes again.
+///
+/// @param root_dirs the root directories to consider.
+void
+revalidate_debug_info_root_indexes(const vector<char**>& root_dirs)
+{
+  for (const auto& root : root_dirs)
+    if (root && *root)
+      get_debug_info_root_index(*root, /*revalidate=*/true);
+}
+
+/// Find a file under a set of debug info root directories, using
+/// their indexes.
+///
+/// This is a faster replacement of calling
+/// tools_utils::find_file_under_dir() on each of the root
+/// directories.
+///
+/// @param root_dirs the root directories to look under.
+///
+/// @param file_path_to_look_for the file to look for.
+///
+/// @param result the resulting absolute path to the file.  This is
+/// set iff the file has been found.
+///
+/// @return true iff the file has been found.
+bool
+find_file_under_debug_info_roots(const vector<char**>&	root_dirs,
+				 const string&		file_path_to_look_for,
+				 string&			result)
+{
+  for (const auto& root : root_dirs)
+    if (root && *root
+	&& get_debug_info_root_index(*root)->find_file(file_path_to_look_for,
+						       result))
+      return true;
+  return false;
+}
+
+/// Convert a build ID into its hexadecimal string representation.
+///
+/// @param build_id the bytes of the build ID.
+///
+/// @param len the number of bytes of the build ID.
+///
+/// @return the hexadecimal string representing the build ID.
+string
+build_id_to_string(const unsigned char* build_id, size_t len)
+{
+  static const char digits[] = "0123456789abcdef";
+  string result;
+  result.reserve(2 * len);
+  for (size_t i = 0; i < len; ++i)
+    {
+      result += digits[build_id[i] >> 4];
+      result += digits[build_id[i] & 0xf];
+    }
+  return result;
+}
+
+/// A function used as the Dwfl_Callbacks::find_debuginfo callback of
+/// elfutils.
+///
+/// It first uses the standard way of finding split debug info files
+/// of elfutils.  If that fails, and if the user data of the module
+/// points to a vector of debug info root directories (of type
+/// vector<char**>), the debug info file is looked up by build ID in
+/// the indexes of those directories.
+///
+/// The parameters are those of dwfl_standard_find_debuginfo().
+///
+/// @return the file descriptor of the debug info file found, or a
+/// negative value if none was found.
+int
+find_debuginfo_from_root_indexes(Dwfl_Module*	module,
+				 void**	userdata,
+				 const char*	module_name,
+				 Dwarf_Addr	base,
+				 const char*	file_name,
+				 const char*	debuglink_file,
+				 GElf_Word	debuglink_crc,
+				 char**	debuginfo_file_name)
+{
+  int fd = dwfl_standard_find_debuginfo(module, userdata, module_name,
+					base, file_name, debuglink_file,
+					debuglink_crc, debuginfo_file_name);
+  if (fd >= 0 || !userdata || !*userdata)
+    return fd;
+
+  const unsigned char* build_id_bits = nullptr;
+  GElf_Addr build_id_vaddr = 0;
+  int len = dwfl_module_build_id(module, &build_id_bits, &build_id_vaddr);
+  if (len <= 0)
+    return fd;
+
+  string build_id = build_id_to_string(build_id_bits, len);
+  const vector<char**>* roots = static_cast<const vector<char**>*>(*userdata);
+  for (const auto& root : *roots)
+    {
+      if (!root || !*root)
+	continue;
+      string path;
+      if (get_debug_info_root_index(*root)->find_file_by_build_id(build_id,
+								  ".debug",
+								  path))
+	{
+	  int result = open(path.c_str(), O_RDONLY);
+	  if (result >= 0)
+	    {
+	      *debuginfo_file_name = strdup(path.c_str());
+	      return result;
+	    }
+	}
+    }
+
+  return fd;
+}
+
 /// Fetch the SONAME ELF property from an ELF binary file.
 ///
 /// @param path The path to the elf file to consider.
@@ -82,6 +82,9 @@ find_symtab_section(Elf* elf_handle);
 Elf_Scn*
 find_dynsym_section(Elf* elf_handle);
 
+uint64_t
+get_decompressed_size_of_debug_sections(Elf* elf_handle);
+
 Elf_Scn*
 find_symbol_table_section(Elf* elf_handle);
 
@@ -165,6 +168,11 @@ get_version_for_symbol(Elf*			elf_handle,
 bool
 get_crc_for_symbol(Elf* elf_handle, GElf_Sym* crc_symbol, uint32_t& crc_value);
 
+bool
+get_crcs_for_symbols(Elf*				elf_handle,
+		     const std::vector<GElf_Sym>&	crc_symbols,
+		     std::vector<uint32_t>&		crc_values);
+
 //
 // Architecture specific helpers
 //
@@ -207,6 +215,88 @@ initialize_dwfl_callbacks(Dwfl_Callbacks&, char**);
 dwfl_sptr
 create_new_dwfl_handle(Dwfl_Callbacks&);
 
+//
+// Helpers to lookup debug info files under root directories
+//
+
+/// An index of the files found under a debug info root directory.
+///
+/// Looking up a split debug info file (or an alternate DWZ debug info
+/// file) by walking the directory tree under a root directory is
+/// expensive, especially when it's done for each one of thousands of
+/// binaries sharing the same roots.  This index is built by walking
+/// the tree only once.  It then maps relative paths, file names and
+/// build IDs (as found in the .build-id/ sub-directories) to files.
+///
+/// An index can be saved into a cache file, so that it can be re-used
+/// by subsequent runs as long as the directories it was built from
+/// are not modified.
+class debug_info_root_index
+{
+  struct priv;
+  std::unique_ptr<priv> priv_;
+
+public:
+
+  debug_info_root_index(const string& root_dir);
+
+  ~debug_info_root_index();
+
+  const string&
+  root_dir() const;
+
+  size_t
+  size() const;
+
+  void
+  build();
+
+  bool
+  is_up_to_date() const;
+
+  bool
+  load(const string& cache_path);
+
+  bool
+  save(const string& cache_path) const;
+
+  bool
+  find_file(const string& file_path_to_look_for, string& result) const;
+
+  bool
+  find_file_by_build_id(const string&	build_id,
+			const string&	suffix,
+			string&	result) const;
+}; // end class debug_info_root_index
+
+/// A convenience typedef for a shared pointer to @ref
+/// debug_info_root_index.
+typedef shared_ptr<debug_info_root_index> debug_info_root_index_sptr;
+
+debug_info_root_index_sptr
+get_debug_info_root_index(const string& root_dir, bool revalidate = false);
+
+void
+revalidate_debug_info_root_indexes(const vector<char**>& root_dirs);
+
+bool
+find_file_under_debug_info_roots(const vector<char**>&	root_dirs,
+				 const string&		file_path_to_look_for,
+				 string&			result);
+
+string
+build_id_to_string(const unsigned char* build_id, size_t len);
+
+int
+find_debuginfo_from_root_indexes(Dwfl_Module*	module,
+				 void**	userdata,
+				 const char*	module_name,
+				 Dwarf_Addr	base,
+				 const char*	file_name,
+				 const char*	debuglink_file,
+				 GElf_Word	debuglink_crc,
+				 char**	debuginfo_file_name);
+
 //
 // Misc Helpers
 //
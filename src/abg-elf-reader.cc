@@ -45,11 +45,16 @@ namespace elf
 /// @param out parameter.  Is set to the file name of the alternate
 /// debug info file, iff this function returns true.
 ///
+/// @param alt_build_id out parameter.  Is set to the build ID of the
+/// alternate debug info file, as an hexadecimal string, iff this
+/// function returns true.
+///
 /// @return true iff the location of the alternate debug info file was
 /// found.
 static bool
 find_alt_dwarf_debug_info_link(Dwfl_Module *elf_module,
-			       string &alt_file_name)
+			       string &alt_file_name,
+			       string &alt_build_id)
 {
   GElf_Addr bias = 0;
   Dwarf *dwarf = dwfl_module_getdwarf(elf_module, &bias);
@@ -94,6 +99,9 @@ find_alt_dwarf_debug_info_link(Dwfl_Module *elf_module,
 	return false;
 
       alt_file_name = alt_name;
+      alt_build_id =
+	elf_helpers::build_id_to_string((const unsigned char*) buildid,
+					buildid_len);
       return true;
     }
 
@@ -110,13 +118,18 @@ find_alt_dwarf_debug_info_link(Dwfl_Module *elf_module,
 /// debug info file.
 ///
 /// This function will thus try to find the .dwz/something.debug file
-/// under some given root directories.
+/// under some given root directories.  The file is first looked up
+/// by build ID, and then by name, using the indexes of the root
+/// directories.
 ///
 /// @param root_dirs the set of root directories to look from.
 ///
 /// @param alt_file_name a relative path to the alternate debug info
 /// file to look for.
 ///
+/// @param alt_build_id the build ID of the alternate debug info file
+/// to look for, as an hexadecimal string.
+///
 /// @param alt_file_path the resulting absolute path to the alternate
 /// debuginfo path denoted by @p alt_file_name and found under one of
 /// the directories in @p root_dirs.  This is set iff the function
@@ -126,11 +139,19 @@ find_alt_dwarf_debug_info_link(Dwfl_Module *elf_module,
 static bool
 find_alt_dwarf_debug_info_path(const vector<char**> root_dirs,
 			       const string &alt_file_name,
+			       const string &alt_build_id,
 			       string &alt_file_path)
 {
   if (alt_file_name.empty())
     return false;
 
+  if (!alt_build_id.empty())
+    for (const auto& root : root_dirs)
+      if (root && *root
+	  && elf_helpers::get_debug_info_root_index(*root)->
+	  find_file_by_build_id(alt_build_id, "", alt_file_path))
+	return true;
+
   string altfile_name = tools_utils::trim_leading_string(alt_file_name, "../");
   // In case the alt dwarf debug info file is to be found under
   // "/usr/lib/debug", look for it under the provided root directories
@@ -138,13 +159,9 @@ find_alt_dwarf_debug_info_path(const vector<char**> root_dirs,
   altfile_name = tools_utils::trim_leading_string(altfile_name,
 						  "/usr/lib/debug/");
 
-  for (vector<char**>::const_iterator i = root_dirs.begin();
-       i != root_dirs.end();
-       ++i)
-    if (tools_utils::find_file_under_dir(**i, altfile_name, alt_file_path))
-      return true;
-
-  return false;
+  return elf_helpers::find_file_under_debug_info_roots(root_dirs,
+						      altfile_name,
+						      alt_file_path);
 }
 
 /// Return the alternate debug info associated to a given main debug
@@ -159,6 +176,11 @@ find_alt_dwarf_debug_info_path(const vector<char**> root_dirs,
 /// path of the alternate debug info file associated to @p elf_module.
 /// This is set iff the function returns a non-null result.
 ///
+/// @param alt_build_id output parameter.  This is set to the
+/// build-id of the alternate debug info file associated to @p
+/// elf_module, as recorded in the .gnu_debugaltlink section, in
+/// hexadecimal form.
+///
 /// @param alt_fd the file descriptor used to access the alternate
 /// debug info.  If this parameter is set by the function, then the
 /// caller needs to fclose it, otherwise the file descriptor is going
@@ -178,13 +200,14 @@ static Dwarf*
 find_alt_dwarf_debug_info(Dwfl_Module *elf_module,
 			  const vector<char**> debug_root_dirs,
 			  string& alt_file_name,
+			  string& alt_build_id,
 			  int& alt_fd)
 {
   if (elf_module == 0)
     return 0;
 
   Dwarf* result = 0;
-  find_alt_dwarf_debug_info_link(elf_module, alt_file_name);
+  find_alt_dwarf_debug_info_link(elf_module, alt_file_name, alt_build_id);
 
 #ifdef LIBDW_HAS_DWARF_GETALT
   // We are on recent versions of elfutils where the function
@@ -224,6 +247,7 @@ find_alt_dwarf_debug_info(Dwfl_Module *elf_module,
       string alt_file_path;
       if (!find_alt_dwarf_debug_info_path(debug_root_dirs,
 					  alt_file_name,
+					  alt_build_id,
 					  alt_file_path))
 	return result;
 
@@ -274,12 +298,20 @@ struct reader::priv
   // and make the DWARF reference it in here.
   Dwarf*				alt_dwarf_handle	= nullptr;
   string				alt_dwarf_path;
+  // The build-id of the alternate DWARF debug info file, in
+  // hexadecimal form.
+  string				alt_dwarf_build_id;
   int					alt_dwarf_fd		= 0;
   Elf_Scn*				ctf_section		= nullptr;
   int					alt_ctf_fd		= 0;
   Elf*					alt_ctf_handle		= nullptr;
   Elf_Scn*				alt_ctf_section	= nullptr;
   Elf_Scn*				btf_section		= nullptr;
+  // The DWARF and CTF debug info are located lazily, the first time
+  // they are needed.  That way, nothing is spent on looking for debug
+  // info when only the ELF symbols are read.
+  bool					dwarf_debug_info_located = false;
+  bool					ctf_debug_info_located	= false;
 
   priv(reader& reeder, const std::string& elf_path,
        const vector<char**>& debug_info_roots)
@@ -311,6 +343,7 @@ struct reader::priv
     dt_needed.clear();
     symt.reset();
     debug_info_root_paths = debug_info_roots;
+    elf_helpers::revalidate_debug_info_root_indexes(debug_info_root_paths);
     offline_callbacks = {};
     dwfl_handle.reset();
     elf_module = nullptr;
@@ -322,6 +355,8 @@ struct reader::priv
     alt_ctf_section = nullptr;
     alt_ctf_handle = nullptr;
     alt_ctf_fd = 0;
+    dwarf_debug_info_located = false;
+    ctf_debug_info_located = false;
   }
 
   /// Setup the necessary plumbing to open the ELF file and find all
@@ -351,6 +386,14 @@ struct reader::priv
     dwfl_report_end(dwfl_handle.get(), 0, 0);
     ABG_ASSERT(elf_module);
 
+    // Let elf_helpers::find_debuginfo_from_root_indexes(), our
+    // callback to find split debug info, know about the debug info
+    // root directories.
+    void** module_user_data = nullptr;
+    dwfl_module_info(elf_module, &module_user_data, 0, 0, 0, 0, 0, 0);
+    if (module_user_data)
+      *module_user_data = &debug_info_root_paths;
+
     // Finally, get and handle at the representation of the ELF file
     // we've just cracked open.
     GElf_Addr bias = 0;
@@ -365,15 +408,20 @@ struct reader::priv
   /// @param alt_file_name the resulting path to the alternate
   /// debuginfo file found.  This is set iff the function returns a
   /// non-nil value.
+  ///
+  /// @param alt_build_id the resulting build-id of the alternate
+  /// debuginfo file.
   Dwarf*
   find_alt_dwarf_debug_info(Dwfl_Module*	elf_module,
 			    string&		alt_file_name,
+			    string&		alt_build_id,
 			    int&		alt_fd)
   {
     Dwarf *result = 0;
     result = elf::find_alt_dwarf_debug_info(elf_module,
 					    debug_info_root_paths,
-					    alt_file_name, alt_fd);
+					    alt_file_name, alt_build_id,
+					    alt_fd);
     return result;
   }
 
@@ -392,9 +440,11 @@ struct reader::priv
         alt_dwarf_fd = 0;
       }
     alt_dwarf_path.clear();
+    alt_dwarf_build_id.clear();
   }
 
-  /// Locate the DWARF debug info in the ELF file.
+  /// Locate the DWARF debug info in the ELF file, unless it was
+  /// located already.
   ///
   /// This also knows how to locate split debug info.
   void
@@ -402,8 +452,9 @@ struct reader::priv
   {
     ABG_ASSERT(dwfl_handle);
 
-    if (dwarf_handle)
+    if (dwarf_debug_info_located)
       return;
+    dwarf_debug_info_located = true;
 
     // First let's see if the ELF file that was cracked open does have
     // some DWARF debug info embedded.
@@ -422,6 +473,7 @@ struct reader::priv
 
     alt_dwarf_handle = find_alt_dwarf_debug_info(elf_module,
 						 alt_dwarf_path,
+						 alt_dwarf_build_id,
 						 alt_dwarf_fd);
   }
 
@@ -467,7 +519,8 @@ struct reader::priv
       for (const auto& path : rdr.debug_info_root_paths())
 	{
 	  std::string file_path;
-	  if (!tools_utils::find_file_under_dir(*path, name, file_path))
+	  if (!elf_helpers::get_debug_info_root_index(*path)->
+	      find_file(name, file_path))
 	    continue;
 
 	  if ((alt_ctf_fd = open(file_path.c_str(), O_RDONLY)) == -1)
@@ -488,13 +541,17 @@ struct reader::priv
   }
 
   /// Locate the CTF debug information associated with the current ELF
-  /// file.  It also locates the CTF debug information that is split
-  /// out in a separate file.
+  /// file, unless it was located already.  It also locates the CTF
+  /// debug information that is split out in a separate file.
   void
   locate_ctf_debug_info()
   {
     ABG_ASSERT(elf_handle);
 
+    if (ctf_debug_info_located)
+      return;
+    ctf_debug_info_located = true;
+
     ctf_section = elf_helpers::find_section_by_name(elf_handle, ".ctf");
     if (ctf_section == nullptr)
       {
@@ -519,8 +576,6 @@ reader::reader(const string&		elf_path,
     priv_(new priv(*this, elf_path, debug_info_roots))
 {
   priv_->crack_open_elf_file();
-  priv_->locate_dwarf_debug_info();
-  priv_->locate_ctf_debug_info();
 }
 
 /// The destructor of the @ref elf::reader type.
@@ -546,8 +601,6 @@ reader::reset(const std::string&	elf_path,
   corpus_path(elf_path);
   priv_->initialize(debug_info_roots);
   priv_->crack_open_elf_file();
-  priv_->locate_dwarf_debug_info();
-  priv_->locate_ctf_debug_info();
 }
 
 /// Getter of the vector of directory paths to look into for split
@@ -591,22 +644,31 @@ reader::elf_handle() const
 /// current ELF file.
 const Dwarf*
 reader::dwarf_debug_info() const
-{return priv_->dwarf_handle;}
+{
+  priv_->locate_dwarf_debug_info();
+  return priv_->dwarf_handle;
+}
 
 /// Test if the binary has DWARF debug info.
 ///
 /// @return true iff the binary has DWARF debug info.
 bool
 reader::has_dwarf_debug_info() const
-{return ((priv_->dwarf_handle != nullptr)
-	  || (priv_->alt_dwarf_handle != nullptr));}
+{
+  priv_->locate_dwarf_debug_info();
+  return ((priv_->dwarf_handle != nullptr)
+	  || (priv_->alt_dwarf_handle != nullptr));
+}
 
 /// Test if the binary has CTF debug info.
 ///
 /// @return true iff the binary has CTF debug info.
 bool
 reader::has_ctf_debug_info() const
-{return (priv_->ctf_section != nullptr);}
+{
+  priv_->locate_ctf_debug_info();
+  return (priv_->ctf_section != nullptr);
+}
 
 /// Test if the binary has BTF debug info.
 ///
@@ -626,7 +688,10 @@ reader::has_btf_debug_info() const
 /// alternate split DWARF information.
 const Dwarf*
 reader::alternate_dwarf_debug_info() const
-{return priv_->alt_dwarf_handle;}
+{
+  priv_->locate_dwarf_debug_info();
+  return priv_->alt_dwarf_handle;
+}
 
 
 /// Getter of the path to the alternate split DWARF information file,
@@ -638,7 +703,27 @@ reader::alternate_dwarf_debug_info() const
 /// on disk.
 const string&
 reader::alternate_dwarf_debug_info_path() const
-{return priv_->alt_dwarf_path;}
+{
+  priv_->locate_dwarf_debug_info();
+  return priv_->alt_dwarf_path;
+}
+
+/// Getter of the build-id of the alternate split DWARF information
+/// file created by the 'DWZ' tool, as recorded in the
+/// .gnu_debugaltlink section of the current ELF file.
+///
+/// As several binaries usually share the same alternate DWARF
+/// information file, this build-id is useful to identify the data
+/// that can be shared by the readers of those binaries.
+///
+/// @return the build-id of the alternate split DWARF information
+/// file, in hexadecimal form, or an empty string if there is none.
+const string&
+reader::alternate_dwarf_debug_info_build_id() const
+{
+  priv_->locate_dwarf_debug_info();
+  return priv_->alt_dwarf_build_id;
+}
 
 /// Check if the underlying elf file refers to an alternate debug info
 /// file associated to it.
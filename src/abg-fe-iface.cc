@@ -326,6 +326,19 @@ fe_iface::maybe_add_var_to_exported_decls(const var_decl* var)
       b->maybe_add_var_to_exported_vars(var);
 }
 
+/// Compute the approximate memory used by the side tables of the
+/// front-end, that is, the data it keeps around in addition to the IR
+/// it builds.
+///
+/// This implementation reports nothing.  Front-ends that keep
+/// significant side tables override it.
+///
+/// @param usage the vector where to append the memory usage of each
+/// side table.
+void
+fe_iface::get_memory_usage(ir::memory_usage_vector&) const
+{}
+
 /// The bitwise OR operator for the @ref fe_iface::status type.
 ///
 /// @param l the left-hand side operand.
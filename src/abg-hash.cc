@@ -95,9 +95,8 @@ size_t
 type_base::hash::operator()(const type_base& t) const
 {
   std::hash<size_t> size_t_hash;
-  std::hash<string> str_hash;
 
-  size_t v = str_hash(typeid(t).name());
+  size_t v = typeid(t).hash_code();
   v = hashing::combine_hashes(v, size_t_hash(t.get_size_in_bits()));
   v = hashing::combine_hashes(v, size_t_hash(t.get_alignment_in_bits()));
 
@@ -129,7 +128,7 @@ struct decl_base::hash
   {
     std::hash<string> str_hash;
 
-    size_t v = str_hash(typeid(d).name());
+    size_t v = typeid(d).hash_code();
     if (!d.get_linkage_name().empty())
       v = hashing::combine_hashes(v, str_hash(d.get_linkage_name()));
     if (!d.get_name().empty())
@@ -150,9 +149,8 @@ struct type_decl::hash
   {
     decl_base::hash decl_hash;
     type_base::hash type_hash;
-    std::hash<string> str_hash;
 
-    size_t v = str_hash(typeid(t).name());
+    size_t v = typeid(t).hash_code();
     v = hashing::combine_hashes(v, decl_hash(t));
     v = hashing::combine_hashes(v, type_hash(t));
 
@@ -168,8 +166,7 @@ struct type_decl::hash
 size_t
 scope_decl::hash::operator()(const scope_decl& d) const
 {
-  std::hash<string> hash_string;
-  size_t v = hash_string(typeid(d).name());
+  size_t v = typeid(d).hash_code();
   for (scope_decl::declarations::const_iterator i =
 	 d.get_member_decls().begin();
        i != d.get_member_decls().end();
@@ -195,9 +192,8 @@ struct scope_type_decl::hash
   {
     decl_base::hash decl_hash;
     type_base::hash type_hash;
-    std::hash<string> str_hash;
 
-    size_t v = str_hash(typeid(t).name());
+    size_t v = typeid(t).hash_code();
     v = hashing::combine_hashes(v, decl_hash(t));
     v = hashing::combine_hashes(v, type_hash(t));
 
@@ -212,9 +208,8 @@ struct qualified_type_def::hash
   {
     type_base::hash type_hash;
     decl_base::hash decl_hash;
-    std::hash<string> str_hash;
 
-    size_t v = str_hash(typeid(t).name());
+    size_t v = typeid(t).hash_code();
     v = hashing::combine_hashes(v, type_hash(t));
     v = hashing::combine_hashes(v, decl_hash(t));
     v = hashing::combine_hashes(v, t.get_cv_quals());
@@ -227,12 +222,11 @@ struct pointer_type_def::hash
   size_t
   operator()(const pointer_type_def& t) const
   {
-    std::hash<string> str_hash;
     type_base::hash type_base_hash;
     decl_base::hash decl_hash;
     type_base::shared_ptr_hash hash_type_ptr;
 
-    size_t v = str_hash(typeid(t).name());
+    size_t v = typeid(t).hash_code();
     v = hashing::combine_hashes(v, decl_hash(t));
     v = hashing::combine_hashes(v, type_base_hash(t));
     v = hashing::combine_hashes(v, hash_type_ptr(t.get_pointed_to_type()));
@@ -250,7 +244,7 @@ struct reference_type_def::hash
     decl_base::hash hash_decl;
     type_base::shared_ptr_hash hash_type_ptr;
 
-    size_t v = hash_str(typeid(t).name());
+    size_t v = typeid(t).hash_code();
     v = hashing::combine_hashes(v, hash_str(t.is_lvalue()
 					    ? "lvalue"
 					    : "rvalue"));
@@ -278,13 +272,12 @@ struct array_type_def::hash
   size_t
   operator()(const array_type_def& t)
   {
-    std::hash<string> hash_str;
     type_base::hash hash_type_base;
     decl_base::hash hash_decl;
     type_base::shared_ptr_hash hash_type_ptr;
     array_type_def::subrange_type::hash hash_subrange;
 
-    size_t v = hash_str(typeid(t).name());
+    size_t v = typeid(t).hash_code();
 
     v = hashing::combine_hashes(v, hash_type_base(t));
     v = hashing::combine_hashes(v, hash_decl(t));
@@ -310,7 +303,7 @@ struct enum_type_decl::hash
     type_base::shared_ptr_hash type_ptr_hash;
     std::hash<size_t> size_t_hash;
 
-    size_t v = str_hash(typeid(t).name());
+    size_t v = typeid(t).hash_code();
     v = hashing::combine_hashes(v, decl_hash(t));
     v = hashing::combine_hashes(v, type_ptr_hash(t.get_underlying_type()));
     for (enum_type_decl::enumerators::const_iterator i =
@@ -330,12 +323,11 @@ struct typedef_decl::hash
   size_t
   operator()(const typedef_decl& t) const
   {
-    std::hash<string> str_hash;
     type_base::hash hash_type;
     decl_base::hash decl_hash;
     type_base::shared_ptr_hash type_ptr_hash;
 
-    size_t v = str_hash(typeid(t).name());
+    size_t v = typeid(t).hash_code();
     v = hashing::combine_hashes(v, hash_type(t));
     v = hashing::combine_hashes(v, decl_hash(t));
     v = hashing::combine_hashes(v, type_ptr_hash(t.get_underlying_type()));
@@ -356,12 +348,11 @@ struct typedef_decl::hash
 size_t
 var_decl::hash::operator()(const var_decl& t) const
 {
-  std::hash<string> hash_string;
   decl_base::hash hash_decl;
   type_base::shared_ptr_hash hash_type_ptr;
   std::hash<size_t> hash_size_t;
 
-  size_t v = hash_string(typeid(t).name());
+  size_t v = typeid(t).hash_code();
   v = hashing::combine_hashes(v, hash_decl(t));
   v = hashing::combine_hashes(v, hash_type_ptr(t.get_type()));
 
@@ -398,11 +389,10 @@ function_decl::hash::operator()(const function_decl& t) const
   std::hash<int> hash_int;
   std::hash<size_t> hash_size_t;
   std::hash<bool> hash_bool;
-  std::hash<string> hash_string;
   decl_base::hash hash_decl_base;
   type_base::shared_ptr_hash hash_type_ptr;
 
-  size_t v = hash_string(typeid(t).name());
+  size_t v = typeid(t).hash_code();
   v = hashing::combine_hashes(v, hash_decl_base(t));
   v = hashing::combine_hashes(v, hash_type_ptr(t.get_type()));
   v = hashing::combine_hashes(v, hash_bool(t.is_declared_inline()));
@@ -468,7 +458,7 @@ struct method_type::hash
     type_base::shared_ptr_hash hash_type_ptr;
     function_decl::parameter::hash hash_parameter;
 
-    size_t v = hash_string(typeid(t).name());
+    size_t v = typeid(t).hash_code();
     string class_name = t.get_class_type()->get_qualified_name();
     v = hashing::combine_hashes(v, hash_string(class_name));
     v = hashing::combine_hashes(v, hash_type_ptr(t.get_return_type()));
@@ -500,11 +490,10 @@ struct method_type::hash
 size_t
 function_type::hash::operator()(const function_type& t) const
 {
-  std::hash<string> hash_string;
   type_base::shared_ptr_hash hash_type_ptr;
   function_decl::parameter::hash hash_parameter;
 
-  size_t v = hash_string(typeid(t).name());
+  size_t v = typeid(t).hash_code();
   v = hashing::combine_hashes(v, hash_type_ptr(t.get_return_type()));
   for (vector<shared_ptr<function_decl::parameter> >::const_iterator i =
 	 t.get_first_non_implicit_parm();
@@ -522,7 +511,7 @@ function_type::hash::operator()(const function_type& t) const
 size_t
 function_type::hash::operator()(const function_type* t) const
 {
-  if (const method_type* m = dynamic_cast<const method_type*>(t))
+  if (const method_type* m = is_method_type(t))
     {
       method_type::hash h;
       return h(m);
@@ -555,9 +544,8 @@ class_decl::base_spec::hash::operator()(const base_spec& t) const
   type_base::shared_ptr_hash hash_type_ptr;
   std::hash<size_t> hash_size;
   std::hash<bool> hash_bool;
-  std::hash<string> hash_string;
 
-  size_t v = hash_string(typeid(t).name());
+  size_t v = typeid(t).hash_code();
   v = hashing::combine_hashes(v, hash_member(t));
   v = hashing::combine_hashes(v, hash_size(t.get_offset_in_bits()));
   v = hashing::combine_hashes(v, hash_bool(t.get_is_virtual()));
@@ -627,13 +615,12 @@ class_or_union::hash::operator()(const class_or_union& t) const
 
   ABG_ASSERT(!t.get_is_declaration_only());
 
-  std::hash<string> hash_string;
   scope_type_decl::hash hash_scope_type;
   var_decl::hash hash_data_member;
   member_function_template::hash hash_member_fn_tmpl;
   member_class_template::hash hash_member_class_tmpl;
 
-  size_t v = hash_string(typeid(t).name());
+  size_t v = typeid(t).hash_code();
   v = hashing::combine_hashes(v, hash_scope_type(t));
 
   t.hashing_started(true);
@@ -706,11 +693,10 @@ class_decl::hash::operator()(const class_decl& t) const
 
   ABG_ASSERT(!t.get_is_declaration_only());
 
-  std::hash<string> hash_string;
   class_decl::base_spec::hash hash_base;
   class_or_union::hash hash_class_or_union;
 
-  size_t v = hash_string(typeid(t).name());
+  size_t v = typeid(t).hash_code();
 
   t.hashing_started(true);
 
@@ -756,10 +742,9 @@ struct template_parameter::hash
     t.set_hashing_has_started(true);
 
     std::hash<unsigned> hash_unsigned;
-    std::hash<std::string> hash_string;
     template_decl::hash hash_template_decl;
 
-    size_t v = hash_string(typeid(t).name());
+    size_t v = typeid(t).hash_code();
     v = hashing::combine_hashes(v, hash_unsigned(t.get_index()));
     v = hashing::combine_hashes(v, hash_template_decl
 				(*t.get_enclosing_template_decl()));
@@ -789,7 +774,7 @@ template_decl::hash::operator()(const template_decl& t) const
   std::hash<string> hash_string;
   template_parameter::shared_ptr_hash hash_template_parameter;
 
-  size_t v = hash_string(typeid(t).name());
+  size_t v = typeid(t).hash_code();
   v = hashing::combine_hashes(v, hash_string(t.get_qualified_name()));
 
   for (list<template_parameter_sptr>::const_iterator p =
@@ -807,11 +792,10 @@ struct type_tparameter::hash
   size_t
   operator()(const type_tparameter& t) const
   {
-    std::hash<string> hash_string;
     template_parameter::hash hash_template_parameter;
     type_decl::hash hash_type;
 
-    size_t v = hash_string(typeid(t).name());
+    size_t v = typeid(t).hash_code();
     v = hashing::combine_hashes(v, hash_template_parameter(t));
     v = hashing::combine_hashes(v, hash_type(t));
 
@@ -831,7 +815,7 @@ non_type_tparameter::hash::operator()(const non_type_tparameter& t) const
   std::hash<string> hash_string;
   type_base::shared_ptr_hash hash_type;
 
-  size_t v = hash_string(typeid(t).name());
+  size_t v = typeid(t).hash_code();
   v = hashing::combine_hashes(v, hash_template_parameter(t));
   v = hashing::combine_hashes(v, hash_string(t.get_name()));
   v = hashing::combine_hashes(v, hash_type(t.get_type()));
@@ -853,11 +837,10 @@ struct template_tparameter::hash
   size_t
   operator()(const template_tparameter& t) const
   {
-    std::hash<string> hash_string;
     type_tparameter::hash hash_template_type_parm;
     template_decl::hash hash_template_decl;
 
-    size_t v = hash_string(typeid(t).name());
+    size_t v = typeid(t).hash_code();
     v = hashing::combine_hashes(v, hash_template_type_parm(t));
     v = hashing::combine_hashes(v, hash_template_decl(t));
 
@@ -891,10 +874,9 @@ operator()(const template_parameter* t) const
 size_t
 type_composition::hash::operator()(const type_composition& t) const
 {
-  std::hash<string> hash_string;
   type_base::dynamic_hash hash_type;
 
-  size_t v = hash_string(typeid(t).name());
+  size_t v = typeid(t).hash_code();
   v = hashing::combine_hashes(v, hash_type(t.get_composed_type().get()));
   return v;
 }
@@ -912,12 +894,11 @@ size_t
 function_tdecl::hash::
 operator()(const function_tdecl& t) const
 {
-  std::hash<string> hash_string;
   decl_base::hash hash_decl_base;
   template_decl::hash hash_template_decl;
   function_decl::hash hash_function_decl;
 
-  size_t v = hash_string(typeid(t).name());
+  size_t v = typeid(t).hash_code();
 
   v = hashing::combine_hashes(v, hash_decl_base(t));
   v = hashing::combine_hashes(v, hash_template_decl(t));
@@ -941,12 +922,11 @@ size_t
 class_tdecl::hash::
 operator()(const class_tdecl& t) const
 {
-  std::hash<string> hash_string;
   decl_base::hash hash_decl_base;
   template_decl::hash hash_template_decl;
   class_decl::hash hash_class_decl;
 
-  size_t v = hash_string(typeid(t).name());
+  size_t v = typeid(t).hash_code();
   v = hashing::combine_hashes(v, hash_decl_base(t));
   v = hashing::combine_hashes(v, hash_template_decl(t));
   if (t.get_pattern())
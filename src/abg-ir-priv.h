@@ -15,6 +15,8 @@
 
 #include <string>
 #include <iostream>
+#include <memory>
+#include <mutex>
 
 #include "abg-ir.h"
 #include "abg-corpus.h"
@@ -378,11 +380,244 @@ typedef unordered_set<const class_or_union*> class_set_type;
 /// A convenience typedef for a set of pointer to @ref function_type.
 typedef unordered_set<const function_type*> fn_set_type;
 
-/// A convenience typedef for a map which key is a pair of uint64_t
-/// and which value is a boolean.  This is initially intended to cache
-/// the result of comparing two (sub-)types.
-typedef unordered_map<uint64_t_pair_type, bool,
-		      uint64_t_pair_hash> type_comparison_result_type;
+/// A bounded cache of the results of comparing two (sub-)types.
+///
+/// The key of an entry is the pair of addresses of the two types
+/// compared and its value is the boolean result of the comparison.
+///
+/// This is an open-addressed hash table of fixed size entries, so
+/// that a lookup touches one or two cache lines.  The table starts
+/// small and doubles its size as it fills up, until it reaches its
+/// capacity.  From then on, inserting an entry in a full probe
+/// sequence evicts one of the entries of that sequence, in a round
+/// robin fashion.  So the memory used by the cache is bounded, even
+/// on kernel-sized corpora.  Evicting an entry is harmless, as the
+/// result of the comparison is just re-computed when needed.
+class type_comparison_result_cache
+{
+  /// An entry of the cache.  The result of the comparison is stored
+  /// in the least significant bit of the second address, which is
+  /// always zero as types are aligned.  An entry which first address
+  /// is zero is free.
+  struct entry
+  {
+    uint64_t first;
+    uint64_t second_and_result;
+  };
+
+  /// The maximum number of slots looked at by a lookup.
+  static const size_t probe_length = 8;
+
+  /// The initial number of slots of the table.
+  static const size_t initial_size = 1024;
+
+  vector<entry>	entries_;
+  size_t	nb_entries_;
+  size_t	capacity_;
+  size_t	next_victim_;
+  environment::type_comparison_cache_stats stats_;
+
+  /// Compute the index of the first slot of the probe sequence of a
+  /// given pair of addresses.
+  ///
+  /// @param first the first address of the pair.
+  ///
+  /// @param second the second address of the pair.
+  ///
+  /// @return the index of the first slot of the probe sequence.
+  size_t
+  home_slot(uint64_t first, uint64_t second) const
+  {
+    uint64_t h = (first * 0x9E3779B97F4A7C15ULL)
+      ^ (second * 0xC2B2AE3D27D4EB4FULL);
+    h ^= h >> 29;
+    return h & (entries_.size() - 1);
+  }
+
+  /// Store an entry in the table, evicting an existing entry if the
+  /// probe sequence of the new one is full.
+  ///
+  /// @param e the entry to store.
+  ///
+  /// @param may_evict if this is false and the probe sequence of @p
+  /// e is full, then @p e is dropped rather than evicting another
+  /// entry.
+  ///
+  /// @return true iff @p e was stored.
+  bool
+  store(const entry& e, bool may_evict)
+  {
+    const uint64_t second = e.second_and_result & ~uint64_t(1);
+    const size_t mask = entries_.size() - 1;
+    size_t slot = home_slot(e.first, second);
+    for (size_t i = 0; i < probe_length; ++i)
+      {
+	entry& candidate = entries_[(slot + i) & mask];
+	if (candidate.first == 0)
+	  {
+	    candidate = e;
+	    ++nb_entries_;
+	    return true;
+	  }
+	if (candidate.first == e.first
+	    && (candidate.second_and_result & ~uint64_t(1)) == second)
+	  {
+	    candidate = e;
+	    return true;
+	  }
+      }
+
+    if (!may_evict)
+      return false;
+
+    entries_[(slot + next_victim_++ % probe_length) & mask] = e;
+    ++stats_.evictions;
+    return true;
+  }
+
+  /// Double the size of the table, unless that would exceed its
+  /// capacity.
+  ///
+  /// An entry which probe sequence is full in the new table is
+  /// dropped rather than evicting an entry that was already moved.
+  /// It's counted as an eviction all the same, so that the counters
+  /// of the cache still account for every result that got lost.
+  ///
+  /// @return true iff the table was grown.
+  bool
+  grow()
+  {
+    if (entries_.size() * 2 > capacity_)
+      return false;
+
+    vector<entry> old_entries(entries_.size() * 2, entry());
+    old_entries.swap(entries_);
+    nb_entries_ = 0;
+    for (const entry& e : old_entries)
+      if (e.first && !store(e, /*may_evict=*/false))
+	++stats_.evictions;
+    return true;
+  }
+
+public:
+
+  /// The default maximum number of entries of the cache.
+  static const size_t default_capacity = 1 << 20;
+
+  type_comparison_result_cache()
+    : nb_entries_(),
+      capacity_(default_capacity),
+      next_victim_(),
+      stats_()
+  {}
+
+  /// Getter of the maximum number of entries of the cache.
+  ///
+  /// @return the maximum number of entries of the cache.
+  size_t
+  capacity() const
+  {return capacity_;}
+
+  /// Getter of the number of entries of the cache.
+  ///
+  /// @return the number of entries of the cache.
+  size_t
+  size() const
+  {return nb_entries_;}
+
+  /// Getter of the number of bytes used by the table of the cache.
+  ///
+  /// @return the number of bytes used by the table of the cache.
+  size_t
+  get_size_in_bytes() const
+  {return entries_.capacity() * sizeof(entry);}
+
+  /// Setter of the maximum number of entries of the cache.
+  ///
+  /// This clears the cache.
+  ///
+  /// @param c the new maximum number of entries.  It's rounded up to
+  /// a power of two, and to the initial size of the cache.
+  void
+  capacity(size_t c)
+  {
+    capacity_ = initial_size;
+    while (capacity_ < c)
+      capacity_ *= 2;
+    clear();
+  }
+
+  /// Getter of the counters of the cache.
+  ///
+  /// @return the counters of the cache.
+  const environment::type_comparison_cache_stats&
+  stats() const
+  {return stats_;}
+
+  /// Add the result of a comparison to the cache.
+  ///
+  /// @param first the address of the first type compared.
+  ///
+  /// @param second the address of the second type compared.
+  ///
+  /// @param result the result of the comparison.
+  void
+  insert(uint64_t first, uint64_t second, bool result)
+  {
+    if (entries_.empty())
+      entries_.resize(initial_size, entry());
+    else if (2 * (nb_entries_ + 1) > entries_.size())
+      grow();
+
+    entry e = {first, second | (result ? 1 : 0)};
+    store(e, /*may_evict=*/true);
+    ++stats_.insertions;
+  }
+
+  /// Look up the result of a comparison in the cache.
+  ///
+  /// @param first the address of the first type compared.
+  ///
+  /// @param second the address of the second type compared.
+  ///
+  /// @param result output parameter.  This is set to the result of
+  /// the comparison, if it's found in the cache.
+  ///
+  /// @return true iff the result of comparing @p first and @p second
+  /// is in the cache.
+  bool
+  find(uint64_t first, uint64_t second, bool& result)
+  {
+    if (!entries_.empty())
+      {
+	const size_t mask = entries_.size() - 1;
+	size_t slot = home_slot(first, second);
+	for (size_t i = 0; i < probe_length; ++i)
+	  {
+	    const entry& e = entries_[(slot + i) & mask];
+	    if (e.first == 0)
+	      break;
+	    if (e.first == first
+		&& (e.second_and_result & ~uint64_t(1)) == second)
+	      {
+		result = e.second_and_result & 1;
+		++stats_.hits;
+		return true;
+	      }
+	  }
+      }
+    ++stats_.misses;
+    return false;
+  }
+
+  /// Remove all the entries of the cache and release its memory.
+  void
+  clear()
+  {
+    vector<entry>().swap(entries_);
+    nb_entries_ = 0;
+  }
+}; // end class type_comparison_result_cache
 
 /// The private data of the @ref environment type.
 struct environment::priv
@@ -407,7 +642,11 @@ struct environment::priv
   // This is a cache for the result of comparing two sub-types (of
   // either class or function types) that are designated by their
   // memory address in the IR.
-  type_comparison_result_type		type_comparison_results_cache_;
+  type_comparison_result_cache		type_comparison_results_cache_;
+  // Maps a type that is not yet canonicalized to a canonical type it
+  // is likely to be equal to.  See
+  // environment::add_canonical_type_hint.
+  unordered_map<const type_base*, type_base*>	canonical_type_hints_;
   vector<type_base_sptr>		extra_live_types_;
   interned_string_pool			string_pool_;
   // The two vectors below represent the stack of left and right
@@ -460,6 +699,17 @@ struct environment::priv
   // must be cleared.
   pointer_set		types_with_non_confirmed_propagated_ct_;
   pointer_set		recursive_types_;
+  // Data that is computed by a front-end and that can be shared by
+  // all the front-ends (readers) using this environment.  For
+  // instance, the data derived from an alternate DWARF debug info
+  // file that is shared by several binaries of a package.  The data
+  // is keyed by a string that is chosen by the front-end that created
+  // it.  The data is owned by the front-ends using it, so it goes
+  // away when the last of them is destroyed.
+  unordered_map<string, std::weak_ptr<void>> shared_front_end_data_;
+  // Protects shared_front_end_data_ as several front-ends might be
+  // reading binaries concurrently in this environment.
+  std::mutex				shared_front_end_data_mutex_;
 #ifdef WITH_DEBUG_CT_PROPAGATION
   // Set of types which propagated canonical type has been cleared
   // during the "canonical type propagation optimization" phase. Those
@@ -532,6 +782,48 @@ struct environment::priv
 #endif
   {}
 
+  /// Get the front-end data associated to a given key, creating it
+  /// if it doesn't exist yet.
+  ///
+  /// The environment doesn't own the data; it's kept alive by the
+  /// front-ends holding the returned pointer.  So once all of them
+  /// are gone, the data is freed and a subsequent call creates it
+  /// anew.  This prevents the data from piling up when a lot of
+  /// binaries are analyzed in the same environment.
+  ///
+  /// This function can be called concurrently.  Note however that
+  /// the returned data object is not protected by any lock; if it's
+  /// to be modified by several threads, then it must contain its own
+  /// synchronization primitives.
+  ///
+  /// @tparam T the type of the data.  It must be default
+  /// constructible.
+  ///
+  /// @param key the key of the data.  Front-ends should prefix their
+  /// keys with their name to avoid clashes.
+  ///
+  /// @return the data associated to @p key.
+  template<typename T>
+  std::shared_ptr<T>
+  get_or_create_shared_front_end_data(const string& key)
+  {
+    std::lock_guard<std::mutex> lock(shared_front_end_data_mutex_);
+    std::shared_ptr<void> data = shared_front_end_data_[key].lock();
+    if (!data)
+      {
+	// Forget about the data that is not used anymore.
+	for (auto i = shared_front_end_data_.begin();
+	     i != shared_front_end_data_.end();)
+	  if (i->second.expired() && i->first != key)
+	    i = shared_front_end_data_.erase(i);
+	  else
+	    ++i;
+	data = std::make_shared<T>();
+	shared_front_end_data_[key] = data;
+      }
+    return std::static_pointer_cast<T>(data);
+  }
+
   /// Allow caching of the sub-types comparison results during the
   /// invocation of the @ref equal overloads for class and function
   /// types.
@@ -575,9 +867,9 @@ struct environment::priv
 	     && !is_type(&first)->priv_->depends_on_recursive_type()
 	     && !is_type(&second)->priv_->depends_on_recursive_type())))
       {
-	type_comparison_results_cache_.emplace
-	  (std::make_pair(reinterpret_cast<uint64_t>(&first),
-			  reinterpret_cast<uint64_t>(&second)),
+	type_comparison_results_cache_.insert
+	  (reinterpret_cast<uint64_t>(&first),
+	   reinterpret_cast<uint64_t>(&second),
 	   r);
       }
   }
@@ -608,15 +900,10 @@ struct environment::priv
     if (!allow_type_comparison_results_caching())
       return false;
 
-    type_comparison_result_type::const_iterator it =
-      type_comparison_results_cache_.find
-	 (std::make_pair(reinterpret_cast<uint64_t>(&first),
-			 reinterpret_cast<uint64_t>(&second)));
-    if (it == type_comparison_results_cache_.end())
-      return false;
-
-    r = it->second;
-    return true;
+    return type_comparison_results_cache_.find
+      (reinterpret_cast<uint64_t>(&first),
+       reinterpret_cast<uint64_t>(&second),
+       r);
   }
 
   /// Clear the cache type comparison results.
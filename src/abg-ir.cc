@@ -129,6 +129,30 @@ interned_string_pool::create_string(const std::string& str_value)
   return interned_string(result);
 }
 
+/// Compute the approximate memory used by the pool.
+///
+/// @param nb_strings output parameter.  This is set to the number of
+/// strings of the pool.
+///
+/// @param nb_bytes output parameter.  This is set to the approximate
+/// number of bytes used by the pool.
+void
+interned_string_pool::get_memory_usage(uint64_t& nb_strings,
+				       uint64_t& nb_bytes) const
+{
+  nb_strings = priv_->map.size();
+  nb_bytes = get_approximate_hash_table_size(priv_->map);
+  for (const auto& i : priv_->map)
+    {
+      // The key of the map holds a copy of the characters of the
+      // string.  Short strings are stored inside the string object
+      // itself, but counting them as allocated is close enough.
+      nb_bytes += i.first.capacity() + 1;
+      if (i.second)
+	nb_bytes += sizeof(string) + i.second->capacity() + 1;
+    }
+}
+
 /// Destructor.
 interned_string_pool::~interned_string_pool()
 {
@@ -3595,6 +3619,156 @@ void
 environment::do_on_the_fly_canonicalization(bool f)
 {priv_->do_on_the_fly_canonicalization_ = f;}
 
+/// Getter of the maximum number of entries of the cache of the
+/// results of type comparisons.
+///
+/// @return the maximum number of entries of the cache.
+size_t
+environment::type_comparison_cache_capacity() const
+{return priv_->type_comparison_results_cache_.capacity();}
+
+/// Setter of the maximum number of entries of the cache of the
+/// results of type comparisons.
+///
+/// Once the cache is full, adding a result to it evicts another one.
+/// Note that setting the capacity clears the cache.
+///
+/// @param c the new maximum number of entries of the cache.  It's
+/// rounded up to a power of two.
+void
+environment::type_comparison_cache_capacity(size_t c)
+{priv_->type_comparison_results_cache_.capacity(c);}
+
+/// Getter of the counters of the cache of the results of type
+/// comparisons.
+///
+/// @return the counters of the cache.
+environment::type_comparison_cache_stats
+environment::get_type_comparison_cache_stats() const
+{return priv_->type_comparison_results_cache_.stats();}
+
+/// Record that a type which is not yet canonicalized is likely to
+/// have a given canonical type.
+///
+/// This is useful when a type is known to represent a type that was
+/// already canonicalized in this environment, like when reading back
+/// an abixml file that was just emitted from this environment.  When
+/// the type gets canonicalized, it's then compared against the
+/// hinted canonical type first, rather than against all the
+/// canonical types of the same name.  The hint is only used if the
+/// two types compare equal, so a wrong hint doesn't change the
+/// result of the canonicalization.
+///
+/// @param t the type to consider.
+///
+/// @param canonical the canonical type @p t is likely to have.  It
+/// is ignored if it doesn't belong to this environment.
+void
+environment::add_canonical_type_hint(const type_base* t,
+				     type_base* canonical)
+{
+  if (!t || !canonical || &canonical->get_environment() != this)
+    return;
+  priv_->canonical_type_hints_[t] = canonical;
+}
+
+/// Forget the hints recorded by environment::add_canonical_type_hint
+/// that were not used.
+void
+environment::clear_canonical_type_hints()
+{priv_->canonical_type_hints_.clear();}
+
+/// Compute the approximate memory used by the main data structures
+/// of the environment.
+///
+/// This reports the interned strings, the map of canonical types, the
+/// canonical types themselves, by kind of type, and the cache of type
+/// comparison results.  For the canonical types, only the memory of
+/// the type objects proper is counted, not the memory they own, like
+/// their data members or their private data.
+///
+/// @param usage the vector where to append the memory usage of each
+/// data structure.
+void
+environment::get_memory_usage(memory_usage_vector& usage) const
+{
+  uint64_t nb_strings = 0, nb_bytes = 0;
+  priv_->string_pool_.get_memory_usage(nb_strings, nb_bytes);
+  usage.push_back(memory_usage("interned strings", nb_strings, nb_bytes));
+
+  // The kinds of canonical types to report on.  More specific kinds
+  // must come first.
+  struct type_kind_usage
+  {
+    type_or_decl_base::type_or_decl_kind kind;
+    const char* name;
+    size_t size;
+    uint64_t count;
+  };
+  type_kind_usage kinds[] =
+    {
+      {type_or_decl_base::METHOD_TYPE, "method types",
+       sizeof(method_type), 0},
+      {type_or_decl_base::FUNCTION_TYPE, "function types",
+       sizeof(function_type), 0},
+      {type_or_decl_base::CLASS_TYPE, "class types",
+       sizeof(class_decl), 0},
+      {type_or_decl_base::UNION_TYPE, "union types",
+       sizeof(union_decl), 0},
+      {type_or_decl_base::ENUM_TYPE, "enum types",
+       sizeof(enum_type_decl), 0},
+      {type_or_decl_base::TYPEDEF_TYPE, "typedefs",
+       sizeof(typedef_decl), 0},
+      {type_or_decl_base::ARRAY_TYPE, "array types",
+       sizeof(array_type_def), 0},
+      {type_or_decl_base::REFERENCE_TYPE, "reference types",
+       sizeof(reference_type_def), 0},
+      {type_or_decl_base::POINTER_TYPE, "pointer types",
+       sizeof(pointer_type_def), 0},
+      {type_or_decl_base::QUALIFIED_TYPE, "qualified types",
+       sizeof(qualified_type_def), 0},
+      {type_or_decl_base::BASIC_TYPE, "basic types",
+       sizeof(type_decl), 0},
+    };
+  uint64_t nb_other_types = 0;
+
+  const canonical_types_map_type& types = priv_->canonical_types_;
+  uint64_t nb_types = 0;
+  nb_bytes = get_approximate_hash_table_size(types);
+  for (const auto& i : types)
+    {
+      nb_bytes += i.first.capacity() + 1;
+      nb_bytes += i.second.capacity() * sizeof(type_base_sptr);
+      nb_types += i.second.size();
+      for (const auto& t : i.second)
+	{
+	  type_or_decl_base::type_or_decl_kind k = t->kind();
+	  bool found = false;
+	  for (auto& u : kinds)
+	    if (k & u.kind)
+	      {
+		++u.count;
+		found = true;
+		break;
+	      }
+	  if (!found)
+	    ++nb_other_types;
+	}
+    }
+  usage.push_back(memory_usage("canonical types map", nb_types, nb_bytes));
+
+  for (const auto& u : kinds)
+    usage.push_back(memory_usage("canonical " + string(u.name),
+				 u.count, u.count * u.size));
+  usage.push_back(memory_usage("other canonical types", nb_other_types,
+			       nb_other_types * sizeof(type_base)));
+
+  usage.push_back
+    (memory_usage("type comparison cache",
+		  priv_->type_comparison_results_cache_.size(),
+		  priv_->type_comparison_results_cache_.get_size_in_bytes()));
+}
+
 /// Getter of the "decl-only-class-equals-definition" flag.
 ///
 /// Usually, a declaration-only class named 'struct foo' compares
@@ -4040,6 +4214,11 @@ struct type_or_decl_base::priv
   // is_type() functions, which also show up during profiling as
   // hotspots, due to their use of dynamic_cast.
   void*			type_or_decl_ptr_;
+  // This holds a pointer to the decl_base sub-object of the current
+  // instance, if it has one.  Unlike type_or_decl_ptr_, this is also
+  // set for types, so that is_decl() doesn't have to fall back to
+  // dynamic_cast for them.
+  decl_base*			decl_ptr_;
   bool				hashing_started_;
   const environment&		env_;
   translation_unit*		translation_unit_;
@@ -4064,6 +4243,7 @@ struct type_or_decl_base::priv
     : kind_(k),
       rtti_(),
       type_or_decl_ptr_(),
+      decl_ptr_(),
       hashing_started_(),
       env_(e),
       translation_unit_(),
@@ -4206,10 +4386,11 @@ void
 type_or_decl_base::runtime_type_instance(void* i)
 {
   priv_->rtti_ = i;
+  priv_->decl_ptr_ = dynamic_cast<decl_base*>(this);
   if (type_base* t = dynamic_cast<type_base*>(this))
     priv_->type_or_decl_ptr_ = t;
-  else if (decl_base *d = dynamic_cast<decl_base*>(this))
-    priv_->type_or_decl_ptr_ = d;
+  else if (priv_->decl_ptr_)
+    priv_->type_or_decl_ptr_ = priv_->decl_ptr_;
 }
 
 /// Getter of the pointer to either the type_base sub-object of the
@@ -4457,6 +4638,10 @@ struct decl_base::priv
   decl_base*		naked_definition_of_declaration_;
   bool			is_declaration_only_;
   typedef_decl_sptr	naming_typedef_;
+  // The hash of the internal pretty representation of the decl, as
+  // used by hash_type_or_decl.  It's cached once the types of the
+  // environment are canonicalized.  Zero means it's not cached.
+  size_t		pretty_representation_hash_;
 
   priv()
     : in_pub_sym_tab_(false),
@@ -4464,7 +4649,8 @@ struct decl_base::priv
       context_(),
       visibility_(VISIBILITY_DEFAULT),
       naked_definition_of_declaration_(),
-      is_declaration_only_(false)
+      is_declaration_only_(false),
+      pretty_representation_hash_()
   {}
 
   priv(interned_string name, interned_string linkage_name, visibility vis)
@@ -4475,7 +4661,8 @@ struct decl_base::priv
       linkage_name_(linkage_name),
       visibility_(vis),
       naked_definition_of_declaration_(),
-      is_declaration_only_(false)
+      is_declaration_only_(false),
+      pretty_representation_hash_()
   {
     is_anonymous_ = name_.empty();
   }
@@ -4729,6 +4916,7 @@ decl_base::set_name(const string& n)
 {
   priv_->name_ = get_environment().intern(n);
   priv_->is_anonymous_ = n.empty();
+  priv_->pretty_representation_hash_ = 0;
 }
 
 /// Test if the current declaration is anonymous.
@@ -4841,6 +5029,7 @@ decl_base::set_linkage_name(const string& m)
 {
   const environment& env = get_environment();
   priv_->linkage_name_ = env.intern(m);
+  priv_->pretty_representation_hash_ = 0;
 }
 
 /// Getter for the visibility of the decl.
@@ -5323,6 +5512,7 @@ decl_base::set_scope(scope_decl* scope)
     priv_->context_ = new context_rel(scope);
   else
     priv_->context_->set_scope(scope);
+  priv_->pretty_representation_hash_ = 0;
 }
 
 // </decl_base definition>
@@ -10072,6 +10262,52 @@ is_template_parameter(const shared_ptr<decl_base> decl)
 		   || dynamic_pointer_cast<template_tparameter>(decl)));
 }
 
+/// Get the runtime type sub-object of an ABI artifact, if the
+/// artifact is of a given kind.
+///
+/// This is the fast replacement of dynamic_cast used by the is_*()
+/// predicates below.  It's only correct for a kind @p k such that
+/// the most derived type of all the artifacts of kind @p k is @p T.
+///
+/// @tparam T the most derived type of the artifacts of kind @p k.
+///
+/// @param t the artifact to consider.
+///
+/// @param k the kind to test @p t against.
+///
+/// @return the sub-object of type @p T of @p t, if @p t is of kind
+/// @p k, nil otherwise.
+template<typename T>
+T*
+runtime_type_instance_of_kind(const type_or_decl_base* t,
+			      type_or_decl_base::type_or_decl_kind k)
+{
+  if (t && (t->kind() & k))
+    return reinterpret_cast<T*>
+      (const_cast<type_or_decl_base*>(t)->runtime_type_instance());
+  return 0;
+}
+
+/// Build a shared pointer to a sub-object of an ABI artifact.
+///
+/// The resulting shared pointer shares the ownership of the
+/// artifact, just like what dynamic_pointer_cast would return.
+///
+/// @param artifact the shared pointer to the artifact.
+///
+/// @param sub_object the sub-object of @p artifact to point to.
+///
+/// @return the shared pointer to @p sub_object, or nil if @p
+/// sub_object is nil.
+template<typename T, typename U>
+static shared_ptr<T>
+sub_object_sptr(const shared_ptr<U>& artifact, T* sub_object)
+{
+  if (!sub_object)
+    return shared_ptr<T>();
+  return shared_ptr<T>(artifact, sub_object);
+}
+
 /// Test whether a declaration is a @ref function_decl.
 ///
 /// @param d the declaration to test for.
@@ -10080,7 +10316,14 @@ is_template_parameter(const shared_ptr<decl_base> decl)
 /// function_decl.  Otherwise, a nil shared pointer.
 function_decl*
 is_function_decl(const type_or_decl_base* d)
-{return dynamic_cast<function_decl*>(const_cast<type_or_decl_base*>(d));}
+{
+  if (method_decl* m =
+      runtime_type_instance_of_kind<method_decl>(d,
+						 type_or_decl_base::METHOD_DECL))
+    return m;
+  return runtime_type_instance_of_kind<function_decl>
+    (d, type_or_decl_base::FUNCTION_DECL);
+}
 
 /// Test whether a declaration is a @ref function_decl.
 ///
@@ -10099,7 +10342,7 @@ is_function_decl(const type_or_decl_base& d)
 /// function_decl.  Otherwise, a nil shared pointer.
 function_decl_sptr
 is_function_decl(const type_or_decl_base_sptr& d)
-{return dynamic_pointer_cast<function_decl>(d);}
+{return sub_object_sptr(d, is_function_decl(d.get()));}
 
 /// Test whether a declaration is a @ref function_decl.
 ///
@@ -10110,8 +10353,8 @@ is_function_decl(const type_or_decl_base_sptr& d)
 function_decl::parameter*
 is_function_parameter(const type_or_decl_base* tod)
 {
-  return dynamic_cast<function_decl::parameter*>
-    (const_cast<type_or_decl_base*>(tod));
+  return runtime_type_instance_of_kind<function_decl::parameter>
+    (tod, type_or_decl_base::FUNCTION_PARAMETER_DECL);
 }
 
 /// Test whether an ABI artifact is a @ref function_decl.
@@ -10122,7 +10365,7 @@ is_function_parameter(const type_or_decl_base* tod)
 /// function_decl.  Otherwise, a nil shared pointer.
 function_decl::parameter_sptr
 is_function_parameter(const type_or_decl_base_sptr tod)
-{return dynamic_pointer_cast<function_decl::parameter>(tod);}
+{return sub_object_sptr(tod, is_function_parameter(tod.get()));}
 
 /// Test if an ABI artifact is a declaration.
 ///
@@ -10144,10 +10387,13 @@ is_decl(const type_or_decl_base* d)
 	return reinterpret_cast<decl_base*>
 	  (const_cast<type_or_decl_base*>(d)->type_or_decl_base_pointer());
 
-      // ... Otherwise, we are in the slow path, which is that the
-      // artifact is a type which has a declaration.  In that case,
-      // let's use the slow dynamic_cast because we don't have the
-      // pointer to the decl sub-object handily present.
+      // ... Otherwise, the artifact is a type which has a
+      // declaration.  The pointer to its decl sub-object has been
+      // recorded when the artifact was constructed.  Only artifacts
+      // which runtime type instance has not been set (if any) need
+      // the slow dynamic_cast.
+      if (decl_base* decl = d->priv_->decl_ptr_)
+	return decl;
       return dynamic_cast<decl_base*>(const_cast<type_or_decl_base*>(d));
     }
   return 0;
@@ -10161,7 +10407,7 @@ is_decl(const type_or_decl_base* d)
 /// declaration, or NULL if it is not.
 decl_base_sptr
 is_decl(const type_or_decl_base_sptr& d)
-{return dynamic_pointer_cast<decl_base>(d);}
+{return sub_object_sptr(d, is_decl(d.get()));}
 
 /// Test if an ABI artifact is a declaration.
 ///
@@ -10192,11 +10438,7 @@ is_decl_slow(const type_or_decl_base_sptr& t)
 /// @return true if the artifact is a type, false otherwise.
 bool
 is_type(const type_or_decl_base& tod)
-{
-  if (dynamic_cast<const type_base*>(&tod))
-    return true;
-  return false;
-}
+{return is_type(&tod);}
 
 /// Test whether a declaration is a type.
 ///
@@ -10220,7 +10462,7 @@ is_type(const type_or_decl_base* t)
 /// @return true if the artifact is a type, false otherwise.
 type_base_sptr
 is_type(const type_or_decl_base_sptr& tod)
-{return dynamic_pointer_cast<type_base>(tod);}
+{return sub_object_sptr(tod, is_type(tod.get()));}
 
 /// Test whether a declaration is a type.
 ///
@@ -10334,7 +10576,11 @@ is_integral_type(const type_or_decl_base_sptr& t)
 /// typedef.
 typedef_decl_sptr
 is_typedef(const type_or_decl_base_sptr t)
-{return dynamic_pointer_cast<typedef_decl>(t);}
+{
+  return sub_object_sptr
+    (t, runtime_type_instance_of_kind<typedef_decl>
+     (t.get(), type_or_decl_base::TYPEDEF_TYPE));
+}
 
 /// Test whether a type is a typedef.
 ///
@@ -10344,7 +10590,10 @@ is_typedef(const type_or_decl_base_sptr t)
 /// typedef.
 const typedef_decl*
 is_typedef(const type_base* t)
-{return dynamic_cast<const typedef_decl*>(t);}
+{
+  return runtime_type_instance_of_kind<typedef_decl>
+    (t, type_or_decl_base::TYPEDEF_TYPE);
+}
 
 /// Test whether a type is a typedef.
 ///
@@ -10354,7 +10603,10 @@ is_typedef(const type_base* t)
 /// typedef.
 typedef_decl*
 is_typedef(type_base* t)
-{return dynamic_cast<typedef_decl*>(t);}
+{
+  return runtime_type_instance_of_kind<typedef_decl>
+    (t, type_or_decl_base::TYPEDEF_TYPE);
+}
 
 /// Test if a type is an enum. This function looks through typedefs.
 ///
@@ -10397,7 +10649,10 @@ is_compatible_with_enum_type(const decl_base_sptr& t)
 /// @return the enum_type_decl* if @p d is an enum, nil otherwise.
 const enum_type_decl*
 is_enum_type(const type_or_decl_base* d)
-{return dynamic_cast<const enum_type_decl*>(d);}
+{
+  return runtime_type_instance_of_kind<enum_type_decl>
+    (d, type_or_decl_base::ENUM_TYPE);
+}
 
 /// Test if a decl is an enum_type_decl
 ///
@@ -10406,7 +10661,10 @@ is_enum_type(const type_or_decl_base* d)
 /// @return the enum_type_decl_sptr if @p d is an enum, nil otherwise.
 enum_type_decl_sptr
 is_enum_type(const type_or_decl_base_sptr& d)
-{return dynamic_pointer_cast<enum_type_decl>(d);}
+{
+  return sub_object_sptr
+    (d, const_cast<enum_type_decl*>(is_enum_type(d.get())));
+}
 
 /// Test if a type is a class. This function looks through typedefs.
 ///
@@ -10474,7 +10732,7 @@ is_class_type(const type_or_decl_base* t)
 /// @return the class_decl if @p t is a class_decl or null otherwise.
 class_decl_sptr
 is_class_type(const type_or_decl_base_sptr& d)
-{return dynamic_pointer_cast<class_decl>(d);}
+{return sub_object_sptr(d, is_class_type(d.get()));}
 
 
 /// Test wheter a type is a declaration-only class.
@@ -10507,7 +10765,11 @@ is_declaration_only_class_type(const type_base_sptr& t)
 /// nil otherwise.
 class_or_union*
 is_class_or_union_type(const type_or_decl_base* t)
-{return dynamic_cast<class_or_union*>(const_cast<type_or_decl_base*>(t));}
+{
+  if (class_decl* c = is_class_type(t))
+    return c;
+  return is_union_type(t);
+}
 
 /// Test if a type is a @ref class_or_union.
 ///
@@ -10517,7 +10779,7 @@ is_class_or_union_type(const type_or_decl_base* t)
 /// nil otherwise.
 shared_ptr<class_or_union>
 is_class_or_union_type(const shared_ptr<type_or_decl_base>& t)
-{return dynamic_pointer_cast<class_or_union>(t);}
+{return sub_object_sptr(t, is_class_or_union_type(t.get()));}
 
 /// Test if a type is a @ref union_decl.
 ///
@@ -10536,7 +10798,10 @@ is_union_type(const type_or_decl_base& t)
 /// otherwise.
 union_decl*
 is_union_type(const type_or_decl_base* t)
-{return dynamic_cast<union_decl*>(const_cast<type_or_decl_base*>(t));}
+{
+  return runtime_type_instance_of_kind<union_decl>
+    (t, type_or_decl_base::UNION_TYPE);
+}
 
 /// Test if a type is a @ref union_decl.
 ///
@@ -10546,7 +10811,7 @@ is_union_type(const type_or_decl_base* t)
 /// otherwise.
 union_decl_sptr
 is_union_type(const shared_ptr<type_or_decl_base>& t)
-{return dynamic_pointer_cast<union_decl>(t);}
+{return sub_object_sptr(t, is_union_type(t.get()));}
 
 /// Test whether a type is a pointer_type_def.
 ///
@@ -10587,7 +10852,7 @@ is_pointer_type(const type_or_decl_base* t)
 /// pointer_type_def, null otherwise.
 pointer_type_def_sptr
 is_pointer_type(const type_or_decl_base_sptr &t)
-{return dynamic_pointer_cast<pointer_type_def>(t);}
+{return sub_object_sptr(t, is_pointer_type(t.get()));}
 
 /// Test whether a type is a reference_type_def.
 ///
@@ -10597,7 +10862,10 @@ is_pointer_type(const type_or_decl_base_sptr &t)
 /// reference_type_def, null otherwise.
 reference_type_def*
 is_reference_type(type_or_decl_base* t)
-{return dynamic_cast<reference_type_def*>(t);}
+{
+  return runtime_type_instance_of_kind<reference_type_def>
+    (t, type_or_decl_base::REFERENCE_TYPE);
+}
 
 /// Test whether a type is a reference_type_def.
 ///
@@ -10607,7 +10875,10 @@ is_reference_type(type_or_decl_base* t)
 /// reference_type_def, null otherwise.
 const reference_type_def*
 is_reference_type(const type_or_decl_base* t)
-{return dynamic_cast<const reference_type_def*>(t);}
+{
+  return runtime_type_instance_of_kind<reference_type_def>
+    (t, type_or_decl_base::REFERENCE_TYPE);
+}
 
 /// Test whether a type is a reference_type_def.
 ///
@@ -10617,7 +10888,7 @@ is_reference_type(const type_or_decl_base* t)
 /// reference_type_def, null otherwise.
 reference_type_def_sptr
 is_reference_type(const type_or_decl_base_sptr& t)
-{return dynamic_pointer_cast<reference_type_def>(t);}
+{return sub_object_sptr(t, is_reference_type(t.get()));}
 
 /// Test if a type is a pointer to void type.
 ///
@@ -10667,7 +10938,10 @@ is_void_pointer_type(const type_base& type)
 /// reference_type_def, null otherwise.
 qualified_type_def*
 is_qualified_type(const type_or_decl_base* t)
-{return dynamic_cast<qualified_type_def*>(const_cast<type_or_decl_base*>(t));}
+{
+  return runtime_type_instance_of_kind<qualified_type_def>
+    (t, type_or_decl_base::QUALIFIED_TYPE);
+}
 
 /// Test whether a type is a qualified_type_def.
 ///
@@ -10677,7 +10951,7 @@ is_qualified_type(const type_or_decl_base* t)
 /// qualified_type_def, null otherwise.
 qualified_type_def_sptr
 is_qualified_type(const type_or_decl_base_sptr& t)
-{return dynamic_pointer_cast<qualified_type_def>(t);}
+{return sub_object_sptr(t, is_qualified_type(t.get()));}
 
 /// Test whether a type is a function_type.
 ///
@@ -10687,7 +10961,7 @@ is_qualified_type(const type_or_decl_base_sptr& t)
 /// function_type, null otherwise.
 function_type_sptr
 is_function_type(const type_or_decl_base_sptr& t)
-{return dynamic_pointer_cast<function_type>(t);}
+{return sub_object_sptr(t, is_function_type(t.get()));}
 
 /// Test whether a type is a function_type.
 ///
@@ -10697,7 +10971,12 @@ is_function_type(const type_or_decl_base_sptr& t)
 /// function_type, null otherwise.
 function_type*
 is_function_type(type_or_decl_base* t)
-{return dynamic_cast<function_type*>(t);}
+{
+  if (method_type* m = is_method_type(t))
+    return m;
+  return runtime_type_instance_of_kind<function_type>
+    (t, type_or_decl_base::FUNCTION_TYPE);
+}
 
 /// Test whether a type is a function_type.
 ///
@@ -10707,7 +10986,7 @@ is_function_type(type_or_decl_base* t)
 /// function_type, null otherwise.
 const function_type*
 is_function_type(const type_or_decl_base* t)
-{return dynamic_cast<const function_type*>(t);}
+{return is_function_type(const_cast<type_or_decl_base*>(t));}
 
 /// Test whether a type is a method_type.
 ///
@@ -10717,7 +10996,7 @@ is_function_type(const type_or_decl_base* t)
 /// method_type, null otherwise.
 method_type_sptr
 is_method_type(const type_or_decl_base_sptr& t)
-{return dynamic_pointer_cast<method_type>(t);}
+{return sub_object_sptr(t, is_method_type(t.get()));}
 
 /// Test whether a type is a method_type.
 ///
@@ -10727,7 +11006,7 @@ is_method_type(const type_or_decl_base_sptr& t)
 /// method_type, null otherwise.
 const method_type*
 is_method_type(const type_or_decl_base* t)
-{return dynamic_cast<const method_type*>(t);}
+{return is_method_type(const_cast<type_or_decl_base*>(t));}
 
 /// Test whether a type is a method_type.
 ///
@@ -10737,7 +11016,10 @@ is_method_type(const type_or_decl_base* t)
 /// method_type, null otherwise.
 method_type*
 is_method_type(type_or_decl_base* t)
-{return dynamic_cast<method_type*>(t);}
+{
+  return runtime_type_instance_of_kind<method_type>
+    (t, type_or_decl_base::METHOD_TYPE);
+}
 
 /// If a class (or union) is a decl-only class, get its definition.
 /// Otherwise, just return the initial class.
@@ -10888,7 +11170,10 @@ look_through_decl_only(const type_base_sptr& t)
 /// otherwise.
 var_decl*
 is_var_decl(const type_or_decl_base* tod)
-{return dynamic_cast<var_decl*>(const_cast<type_or_decl_base*>(tod));}
+{
+  return runtime_type_instance_of_kind<var_decl>
+    (tod, type_or_decl_base::VAR_DECL);
+}
 
 /// Tests if a declaration is a variable declaration.
 ///
@@ -10898,7 +11183,7 @@ is_var_decl(const type_or_decl_base* tod)
 /// otherwise.
 var_decl_sptr
 is_var_decl(const type_or_decl_base_sptr& decl)
-{return dynamic_pointer_cast<var_decl>(decl);}
+{return sub_object_sptr(decl, is_var_decl(decl.get()));}
 
 /// Tests if a declaration is a namespace declaration.
 ///
@@ -10907,7 +11192,7 @@ is_var_decl(const type_or_decl_base_sptr& decl)
 /// @return the namespace declaration if @p d is a namespace.
 namespace_decl_sptr
 is_namespace(const decl_base_sptr& d)
-{return dynamic_pointer_cast<namespace_decl>(d);}
+{return sub_object_sptr(d, is_namespace(d.get()));}
 
 /// Tests if a declaration is a namespace declaration.
 ///
@@ -10916,7 +11201,10 @@ is_namespace(const decl_base_sptr& d)
 /// @return the namespace declaration if @p d is a namespace.
 namespace_decl*
 is_namespace(const decl_base* d)
-{return dynamic_cast<namespace_decl*>(const_cast<decl_base*>(d));}
+{
+  return runtime_type_instance_of_kind<namespace_decl>
+    (d, type_or_decl_base::NAMESPACE_DECL);
+}
 
 /// Tests whether a decl is a template parameter composition type.
 ///
@@ -10952,7 +11240,10 @@ is_function_template_pattern(const shared_ptr<decl_base> decl)
 /// @return true iff @p type is an array_type_def.
 array_type_def*
 is_array_type(const type_or_decl_base* type)
-{return dynamic_cast<array_type_def*>(const_cast<type_or_decl_base*>(type));}
+{
+  return runtime_type_instance_of_kind<array_type_def>
+    (type, type_or_decl_base::ARRAY_TYPE);
+}
 
 /// Test if a type is an array_type_def.
 ///
@@ -10961,7 +11252,7 @@ is_array_type(const type_or_decl_base* type)
 /// @return true iff @p type is an array_type_def.
 array_type_def_sptr
 is_array_type(const type_or_decl_base_sptr& type)
-{return dynamic_pointer_cast<array_type_def>(type);}
+{return sub_object_sptr(type, is_array_type(type.get()));}
 
 /// Tests if the element of a given array is a qualified type.
 ///
@@ -14637,23 +14928,46 @@ type_base::get_canonical_type_for(type_base_sptr t)
   else
     {
       vector<type_base_sptr> &v = i->second;
+
+      // If 't' was given a hint about its canonical type, compare it
+      // against that one first.  The hinted type is used only if it's
+      // one of the canonical types of that name and if it's equal to
+      // 't'.
+      if (!env.priv_->canonical_type_hints_.empty())
+	{
+	  auto h = env.priv_->canonical_type_hints_.find(t.get());
+	  if (h != env.priv_->canonical_type_hints_.end())
+	    {
+	      type_base* hint = h->second;
+	      env.priv_->canonical_type_hints_.erase(h);
+	      for (auto& c : v)
+		if (c.get() == hint)
+		  {
+		    if (compare_canonical_type_against_candidate(c, t))
+		      result = c;
+		    break;
+		  }
+	    }
+	}
+
       // Let's compare 't' structurally (i.e, compare its sub-types
       // recursively) against the canonical types of the system. If it
       // equals a given canonical type C, then it means C is the
       // canonical type of 't'.  Otherwise, if 't' is different from
       // all the canonical types of the system, then it means 't' is a
       // canonical type itself.
-      for (vector<type_base_sptr>::const_reverse_iterator it = v.rbegin();
-	   it != v.rend();
-	   ++it)
-	{
-	  bool equal = compare_canonical_type_against_candidate(*it, t);
-	  if (equal)
-	    {
-	      result = *it;
-	      break;
-	    }
-	}
+      if (!result)
+	for (vector<type_base_sptr>::const_reverse_iterator it = v.rbegin();
+	     it != v.rend();
+	     ++it)
+	  {
+	    bool equal = compare_canonical_type_against_candidate(*it, t);
+	    if (equal)
+	      {
+		result = *it;
+		break;
+	      }
+	  }
 #ifdef WITH_DEBUG_SELF_COMPARISON
       if (env.self_comparison_debug_is_on())
 	{
@@ -19316,7 +19630,10 @@ var_decl::get_type() const
 /// @param the new type of the variable.
 void
 var_decl::set_type(type_base_sptr& t)
-{priv_->set_type(t);}
+{
+  priv_->set_type(t);
+  decl_base::priv_->pretty_representation_hash_ = 0;
+}
 
 /// Getter of the type of the variable.
 ///
@@ -20823,6 +21140,7 @@ function_decl::set_type(const function_type_sptr& fn_type)
 {
   priv_->type_ = fn_type;
   priv_->naked_type_ = fn_type.get();
+  decl_base::priv_->pretty_representation_hash_ = 0;
 }
 
 /// This sets the underlying ELF symbol for the current function decl.
@@ -23623,8 +23941,8 @@ operator!=(const method_decl_sptr& l, const method_decl_sptr& r)
 method_decl*
 is_method_decl(const type_or_decl_base *d)
 {
-  return dynamic_cast<method_decl*>
-    (const_cast<type_or_decl_base*>(d));
+  return runtime_type_instance_of_kind<method_decl>
+    (d, type_or_decl_base::METHOD_DECL);
 }
 
 /// Test if a function_decl is actually a method_decl.
@@ -23645,7 +23963,7 @@ is_method_decl(const type_or_decl_base&d)
 /// a method_decl type.
 method_decl_sptr
 is_method_decl(const type_or_decl_base_sptr& d)
-{return dynamic_pointer_cast<method_decl>(d);}
+{return sub_object_sptr(d, is_method_decl(d.get()));}
 
 /// A "less than" functor to sort a vector of instances of
 /// method_decl that are virtual.
@@ -26325,6 +26643,34 @@ keep_type_alive(type_base_sptr t)
   env.priv_->extra_live_types_.push_back(t);
 }
 
+/// Hash the internal pretty representation of a declaration.
+///
+/// This is a subroutine of hash_type_or_decl.
+///
+/// Building the pretty representation of a declaration is costly and
+/// hash_type_or_decl is invoked a lot on the same declarations when
+/// diffing corpora.  So once the types of the environment are
+/// canonicalized, the hash is cached in the declaration.  The cache
+/// is invalidated when the name, the linkage name, the scope or the
+/// type of the declaration changes.
+///
+/// @param d the declaration to consider.
+///
+/// @return the hash of the internal pretty representation of @p d.
+static size_t
+hash_pretty_representation(const decl_base& d)
+{
+  size_t h = d.priv_->pretty_representation_hash_;
+  if (h)
+    return h;
+
+  std::hash<string> hash_string;
+  h = hash_string(d.get_pretty_representation(/*internal=*/true));
+  if (d.get_environment().canonicalization_is_done())
+    d.priv_->pretty_representation_hash_ = h;
+  return h;
+}
+
 /// Hash an ABI artifact that is either a type or a decl.
 ///
 /// This function intends to provides the fastest possible hashing for
@@ -26358,18 +26704,14 @@ hash_type_or_decl(const type_or_decl_base *tod)
 	{
 	  ABG_ASSERT(v->get_type());
 	  size_t h = hash_type_or_decl(v->get_type());
-	  string repr = v->get_pretty_representation(/*internal=*/true);
-	  std::hash<string> hash_string;
-	  h = hashing::combine_hashes(h, hash_string(repr));
+	  h = hashing::combine_hashes(h, hash_pretty_representation(*v));
 	  result = h;
 	}
       else if (function_decl* f = is_function_decl(d))
 	{
 	  ABG_ASSERT(f->get_type());
 	  size_t h = hash_type_or_decl(f->get_type());
-	  string repr = f->get_pretty_representation(/*internal=*/true);
-	  std::hash<string> hash_string;
-	  h = hashing::combine_hashes(h, hash_string(repr));
+	  h = hashing::combine_hashes(h, hash_pretty_representation(*f));
 	  result = h;
 	}
       else if (function_decl::parameter* p = is_function_parameter(d))
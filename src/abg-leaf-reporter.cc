@@ -63,7 +63,9 @@ leaf_reporter::diff_has_net_changes(const corpus_diff *d) const
 	  || stats.net_num_removed_func_syms()
 	  || stats.net_num_added_func_syms()
 	  || stats.net_num_removed_var_syms()
-	  || stats.net_num_added_var_syms());
+	  || stats.net_num_added_var_syms()
+	  || stats.num_func_syms_changed()
+	  || stats.num_var_syms_changed());
 }
 
 /// Report the changes carried by the diffs contained in an instance
@@ -1405,6 +1407,10 @@ leaf_reporter::report(const corpus_diff& d,
 	out << "\n";
     }
 
+  // Report changed function symbols not referenced by any debug
+  // info.
+  maybe_report_changed_unrefed_symbols(d, /*fn_syms=*/true, indent, out);
+
   // Report removed variable symbols not referenced by any debug info.
   if (ctxt->show_symbols_unreferenced_by_debug_info()
       && d.priv_->deleted_unrefed_var_syms_.size())
@@ -1483,6 +1489,10 @@ leaf_reporter::report(const corpus_diff& d,
   const diff_maps& leaf_diffs = d.get_leaf_diffs();
   report_type_changes_from_diff_maps(*this, leaf_diffs, out, indent);
 
+  // Report changed variable symbols not referenced by any debug
+  // info.
+  maybe_report_changed_unrefed_symbols(d, /*fn_syms=*/false, indent, out);
+
   // Report added/removed/changed types not reacheable from public
   // interfaces.
   maybe_report_unreachable_type_changes(d, s, indent, out);
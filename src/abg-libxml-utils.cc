@@ -5,6 +5,8 @@
 
 /// @file
 
+#include <unistd.h>
+#include <cerrno>
 #include <string>
 #include <iostream>
 
@@ -13,6 +15,7 @@
 ABG_BEGIN_EXPORT_DECLARATIONS
 
 #include "abg-libxml-utils.h"
+#include "abg-tools-utils.h"
 
 ABG_END_EXPORT_DECLARATIONS
 // </headers defining libabigail's API>
@@ -44,14 +47,90 @@ namespace xml
 {
 using std::istream;
 
+/// The input of an xmlTextReader that reads the decompressed content
+/// of a compressed file.
+struct decompressed_input
+{
+  /// The file descriptor to read the decompressed content from.
+  int fd;
+  /// The process id of the decompression process.
+  pid_t pid;
+};
+
+/// This is an xmlInputReadCallback, meant to be passed to
+/// xmlReaderForIO.  It reads a number of bytes from the decompressed
+/// content of a compressed file.
+///
+/// @param context a decompressed_input* cast into a void*.
+///
+/// @param buffer the buffer where to copy the data read.
+///
+/// @param len the number of bytes to read.
+///
+/// @return the number of bytes read or -1 in case of error.
+static int
+decompressed_input_read(void*	context,
+			char*	buffer,
+			int	len)
+{
+  decompressed_input* in = reinterpret_cast<decompressed_input*>(context);
+  for (;;)
+    {
+      ssize_t n = read(in->fd, buffer, len);
+      if (n < 0 && errno == EINTR)
+	continue;
+      return n;
+    }
+}
+
+/// This is an xmlInputCloseCallback, meant to be passed to
+/// xmlReaderForIO.  It closes the decompressed input and waits for
+/// the decompression process.
+///
+/// @param context a decompressed_input* cast into a void*.
+///
+/// @return 0 if the decompression went fine, -1 otherwise.
+static int
+decompressed_input_close(void* context)
+{
+  decompressed_input* in = reinterpret_cast<decompressed_input*>(context);
+  close(in->fd);
+  bool is_ok = tools_utils::wait_for_compression_process(in->pid);
+  delete in;
+  return is_ok ? 0 : -1;
+}
+
 /// Instantiate an xmlTextReader that parses the content of an on-disk
 /// file, wrap it into a smart pointer and return it.
 ///
+/// If the file is compressed with one of the schemes of
+/// tools_utils::compression_kind, then its content is decompressed
+/// on the fly, while it's being parsed.
+///
 /// @param path the path to the file to be parsed by the returned
 /// instance of xmlTextReader.
 reader_sptr
 new_reader_from_file(const std::string& path)
 {
+  tools_utils::compression_kind compression =
+    tools_utils::guess_compression_kind(path);
+  if (compression != tools_utils::COMPRESSION_NONE)
+    {
+      pid_t pid = 0;
+      int fd = tools_utils::open_decompressed_file(path, compression, pid);
+      if (fd < 0)
+	return reader_sptr();
+
+      decompressed_input* in = new decompressed_input;
+      in->fd = fd;
+      in->pid = pid;
+      // The close callback is invoked by libxml2 even if the reader
+      // can't be created, so it takes care of freeing IN.
+      return build_sptr(xmlReaderForIO(&decompressed_input_read,
+				       &decompressed_input_close,
+				       in, path.c_str(), 0, 0));
+    }
+
   reader_sptr p =
     build_sptr(xmlNewTextReaderFilename (path.c_str()));
 
@@ -190,27 +269,40 @@ void
 escape_xml_string(const std::string& str,
 		  std::string& escaped)
 {
-  for (std::string::const_iterator i = str.begin(); i != str.end(); ++i)
-    switch (*i)
-      {
-      case '<':
-	escaped += "&lt;";
-	break;
-      case '>':
-	escaped += "&gt;";
-	break;
-      case '&':
-	escaped += "&amp;";
-	break;
-      case '\'':
-	escaped += "&apos;";
-	break;
-      case '"':
-	escaped += "&quot;";
-	break;
-      default:
-	escaped += *i;
-      }
+  // Most strings have nothing to escape, so copy the runs of
+  // characters that don't need escaping in one go, rather than one
+  // character at a time.
+  escaped.reserve(escaped.size() + str.size());
+  std::string::size_type start = 0;
+  while (start < str.size())
+    {
+      std::string::size_type i = str.find_first_of("<>&'\"", start);
+      if (i == std::string::npos)
+	{
+	  escaped.append(str, start, std::string::npos);
+	  break;
+	}
+      escaped.append(str, start, i - start);
+      switch (str[i])
+	{
+	case '<':
+	  escaped += "&lt;";
+	  break;
+	case '>':
+	  escaped += "&gt;";
+	  break;
+	case '&':
+	  escaped += "&amp;";
+	  break;
+	case '\'':
+	  escaped += "&apos;";
+	  break;
+	case '"':
+	  escaped += "&quot;";
+	  break;
+	}
+      start = i + 1;
+    }
 }
 
 /// Escape the 5 characters representing the predefined XML entities.
@@ -35,6 +35,7 @@ ABG_BEGIN_EXPORT_DECLARATIONS
 #include "abg-corpus.h"
 #include "abg-fe-iface.h"
 #include "abg-tools-utils.h"
+#include "abg-workers.h"
 
 ABG_END_EXPORT_DECLARATIONS
 // </headers defining libabigail's API>
@@ -98,6 +99,249 @@ read_symbol_db_from_input(reader&			rdr,
 static translation_unit_sptr
 read_translation_unit_from_input(fe_iface& rdr);
 
+/// A map whose keys are the type ids found in abixml files.
+///
+/// The abixml writer emits type ids that are either of the form
+/// "type-id-<N>", where N is a decimal number, or hexadecimal hash
+/// values of at least 8 digits, depending on its type id style.  Rather
+/// than hashing these strings at each lookup, this map parses them
+/// into integers.  The values of "type-id-<N>" ids are then stored in
+/// a dense table indexed by N, and the values of the hash-like ids in
+/// a hash table keyed by the hash value.  Other ids are stored in a
+/// hash table keyed by the id string.
+///
+/// The dense table only grows to hold an id N if N is not much
+/// bigger than the number of "type-id-<N>" ids seen so far.  So a
+/// file with a few huge N doesn't make it allocate a huge table.  The
+/// values of these ids are stored in a hash table keyed by N instead.
+///
+/// A default-constructed value of type @p T is considered to be the
+/// absence of a value.
+template<typename T>
+class type_id_map
+{
+  // The number of slots the dense table can have beyond twice the
+  // number of "type-id-<N>" ids it holds.
+  static const uint64_t dense_slack = 1024;
+
+  // Using a deque keeps references to the values valid when the
+  // table grows.
+  std::deque<T>				m_dense_values;
+  // The values of the "type-id-<N>" ids that are too big for the
+  // dense table.
+  unordered_map<uint64_t, T>		m_sparse_values;
+  unordered_map<uint64_t, T>		m_hash_values;
+  unordered_map<string, T>		m_string_values;
+  // The number of "type-id-<N>" ids which got a value.
+  uint64_t				m_nb_sequence_ids;
+  bool					m_is_empty;
+
+  /// The kind of a type id.
+  enum id_kind
+  {
+    SEQUENCE_ID,
+    HASH_ID,
+    OTHER_ID
+  };
+
+  /// Parse a type id into an integer.
+  ///
+  /// Only the ids that can't be confused with another id having the
+  /// same integer value are parsed.
+  ///
+  /// @param id the type id to parse.
+  ///
+  /// @param value output parameter.  This is set to the integer value
+  /// of @p id iff the function doesn't return OTHER_ID.
+  ///
+  /// @return the kind of @p id.
+  static id_kind
+  parse_id(const string& id, uint64_t& value)
+  {
+    static const char prefix[] = "type-id-";
+    const size_t prefix_len = sizeof(prefix) - 1;
+    const size_t len = id.size();
+
+    if (len > prefix_len
+	&& len <= prefix_len + 9
+	&& id.compare(0, prefix_len, prefix) == 0
+	&& (id[prefix_len] != '0' || len == prefix_len + 1))
+      {
+	value = 0;
+	for (size_t i = prefix_len; i < len; ++i)
+	  {
+	    if (id[i] < '0' || id[i] > '9')
+	      return OTHER_ID;
+	    value = value * 10 + (id[i] - '0');
+	  }
+	return SEQUENCE_ID;
+      }
+
+    // Hash-like ids are zero-padded to 8 digits.  So longer ids with
+    // leading zeros are not parsed, as they would have the same value
+    // as a shorter id.
+    if (len >= 8 && len <= 16 && (len == 8 || id[0] != '0'))
+      {
+	value = 0;
+	for (size_t i = 0; i < len; ++i)
+	  {
+	    char c = id[i];
+	    if (c >= '0' && c <= '9')
+	      value = (value << 4) | (c - '0');
+	    else if (c >= 'a' && c <= 'f')
+	      value = (value << 4) | (c - 'a' + 10);
+	    else
+	      return OTHER_ID;
+	  }
+	return HASH_ID;
+      }
+
+    return OTHER_ID;
+  }
+
+  /// Test if a value denotes the absence of a value.
+  ///
+  /// @param v the value to consider.
+  ///
+  /// @return true iff @p v is a default-constructed value.
+  static bool
+  is_absent(const T& v)
+  {return v == T();}
+
+public:
+
+  type_id_map()
+    : m_nb_sequence_ids(),
+      m_is_empty(true)
+  {}
+
+  /// Lookup the value associated to a type id.
+  ///
+  /// @param id the type id to consider.
+  ///
+  /// @return a pointer to the value associated to @p id, or nullptr
+  /// if there is none.
+  const T*
+  lookup(const string& id) const
+  {
+    uint64_t value = 0;
+    const T* result = nullptr;
+    switch (parse_id(id, value))
+      {
+      case SEQUENCE_ID:
+	if (value < m_dense_values.size()
+	    && !is_absent(m_dense_values[value]))
+	  result = &m_dense_values[value];
+	else if (!m_sparse_values.empty())
+	  {
+	    auto i = m_sparse_values.find(value);
+	    if (i != m_sparse_values.end())
+	      result = &i->second;
+	  }
+	break;
+      case HASH_ID:
+	{
+	  auto i = m_hash_values.find(value);
+	  if (i != m_hash_values.end())
+	    result = &i->second;
+	}
+	break;
+      case OTHER_ID:
+	{
+	  auto i = m_string_values.find(id);
+	  if (i != m_string_values.end())
+	    result = &i->second;
+	}
+	break;
+      }
+
+    if (result && is_absent(*result))
+      return nullptr;
+    return result;
+  }
+
+  /// Lookup the value associated to a type id.
+  ///
+  /// @param id the type id to consider.
+  ///
+  /// @return a pointer to the value associated to @p id, or nullptr
+  /// if there is none.
+  T*
+  lookup(const string& id)
+  {
+    return const_cast<T*>
+      (const_cast<const type_id_map*>(this)->lookup(id));
+  }
+
+  /// Get the value associated to a type id, creating it if need be.
+  ///
+  /// @param id the type id to consider.
+  ///
+  /// @return the value associated to @p id.
+  T&
+  operator[](const string& id)
+  {
+    m_is_empty = false;
+    uint64_t value = 0;
+    switch (parse_id(id, value))
+      {
+      case SEQUENCE_ID:
+	{
+	  // The value might have been stored in the sparse table before
+	  // the dense table grew enough to hold it.
+	  if (!m_sparse_values.empty())
+	    {
+	      auto i = m_sparse_values.find(value);
+	      if (i != m_sparse_values.end())
+		return i->second;
+	    }
+
+	  if (value >= m_dense_values.size())
+	    {
+	      if (value >= 2 * m_nb_sequence_ids + dense_slack)
+		{
+		  T& v = m_sparse_values[value];
+		  if (is_absent(v))
+		    ++m_nb_sequence_ids;
+		  return v;
+		}
+	      m_dense_values.resize(value + 1);
+	    }
+
+	  T& v = m_dense_values[value];
+	  if (is_absent(v))
+	    ++m_nb_sequence_ids;
+	  return v;
+	}
+      case HASH_ID:
+	return m_hash_values[value];
+      case OTHER_ID:
+	break;
+      }
+    return m_string_values[id];
+  }
+
+  /// Test if no value was ever associated to a type id.
+  ///
+  /// @return true iff operator[] was not invoked since the map was
+  /// created or last cleared.
+  bool
+  empty() const
+  {return m_is_empty;}
+
+  /// Remove all the values of the map.
+  void
+  clear()
+  {
+    m_dense_values.clear();
+    m_sparse_values.clear();
+    m_hash_values.clear();
+    m_string_values.clear();
+    m_nb_sequence_ids = 0;
+    m_is_empty = true;
+  }
+}; // end class type_id_map
+
 /// The ABIXML reader object.
 ///
 /// This abstracts the context in which the current ABI
@@ -109,14 +353,6 @@ class reader : public fe_iface
 {
 public:
 
-  typedef unordered_map<string,
-			vector<type_base_sptr> >::const_iterator
-  const_types_map_it;
-
-  typedef unordered_map<string,
-			vector<type_base_sptr> >::iterator
-  types_map_it;
-
   typedef unordered_map<string,
 			shared_ptr<function_tdecl> >::const_iterator
   const_fn_tmpl_map_it;
@@ -125,7 +361,7 @@ public:
 			shared_ptr<class_tdecl> >::const_iterator
   const_class_tmpl_map_it;
 
-  typedef unordered_map<string, xmlNodePtr> string_xml_node_map;
+  typedef type_id_map<xmlNodePtr> string_xml_node_map;
 
   typedef unordered_map<xmlNodePtr, decl_base_sptr> xml_node_decl_base_sptr_map;
 
@@ -136,12 +372,13 @@ public:
 	 get_artifact_used_by_relation_map(reader& rdr);
 
 private:
-  unordered_map<string, vector<type_base_sptr> >	m_types_map;
+  type_id_map<vector<type_base_sptr> >			m_types_map;
   unordered_map<string, shared_ptr<function_tdecl> >	m_fn_tmpl_map;
   unordered_map<string, shared_ptr<class_tdecl> >	m_class_tmpl_map;
   vector<type_base_sptr>				m_types_to_canonicalize;
   string_xml_node_map					m_id_xml_node_map;
   xml_node_decl_base_sptr_map				m_xml_node_decl_map;
+  unordered_map<string, type_base*>			m_canonical_type_hints;
   xml::reader_sptr					m_reader;
   xmlNodePtr						m_corp_node;
   deque<shared_ptr<decl_base> >			m_decls_stack;
@@ -190,6 +427,32 @@ public:
   tracking_non_reachable_types(bool f)
   {m_tracking_non_reachable_types = f;}
 
+  /// Compute the approximate memory used by the side tables of the
+  /// abixml reader.
+  ///
+  /// @param usage the vector where to append the memory usage of
+  /// each side table.
+  virtual void
+  get_memory_usage(memory_usage_vector& usage) const
+  {
+    usage.push_back
+      (memory_usage("abixml XML node -> decl map",
+		    m_xml_node_decl_map.size(),
+		    get_approximate_hash_table_size(m_xml_node_decl_map)));
+    usage.push_back
+      (memory_usage("abixml canonical type hints",
+		    m_canonical_type_hints.size(),
+		    get_approximate_hash_table_size(m_canonical_type_hints)));
+  }
+
+  /// Setter of the canonical types that the types of a given type id
+  /// are likely to have.
+  ///
+  /// @param hints the map of type ids and canonical types.
+  void
+  canonical_type_hints(unordered_map<string, type_base*> hints)
+  {m_canonical_type_hints = std::move(hints);}
+
   /// Getter for the flag that tells us if we are dropping functions
   /// and variables that have undefined symbols.
   ///
@@ -310,13 +573,12 @@ public:
     if (!node)
       return;
 
-    string_xml_node_map::iterator i = get_id_xml_node_map().find(id);
-    if (i != get_id_xml_node_map().end())
+    if (xmlNodePtr* n = get_id_xml_node_map().lookup(id))
       {
 	bool is_declaration = false;
 	read_is_declaration_only(node, is_declaration);
 	if (is_declaration)
-	  i->second = node;
+	  *n = node;
       }
     else
       get_id_xml_node_map()[id] = node;
@@ -325,9 +587,8 @@ public:
   xmlNodePtr
   get_xml_node_from_id(const string& id) const
   {
-    string_xml_node_map::const_iterator i = get_id_xml_node_map().find(id);
-    if (i != get_id_xml_node_map().end())
-     return i->second;
+    if (const xmlNodePtr* n = get_id_xml_node_map().lookup(id))
+      return *n;
     return 0;
   }
 
@@ -355,10 +616,10 @@ public:
   type_base_sptr
   get_type_decl(const string& id) const
   {
-    const_types_map_it i = m_types_map.find(id);
-    if (i == m_types_map.end())
+    const vector<type_base_sptr>* types = m_types_map.lookup(id);
+    if (!types)
       return type_base_sptr();
-    type_base_sptr result = i->second[0];
+    type_base_sptr result = (*types)[0];
     return result;
   }
 
@@ -377,11 +638,7 @@ public:
   const vector<type_base_sptr>*
   get_all_type_decls(const string& id) const
   {
-    const_types_map_it i = m_types_map.find(id);
-    if (i == m_types_map.end())
-      return 0;
-    else
-      return &i->second;
+    return m_types_map.lookup(id);
   }
 
   /// Return the function template that is identified by a unique ID.
@@ -591,6 +848,13 @@ public:
 
     m_types_map[id].push_back(type);
 
+    if (!m_canonical_type_hints.empty())
+      {
+	auto i = m_canonical_type_hints.find(id);
+	if (i != m_canonical_type_hints.end())
+	  get_environment().add_canonical_type_hint(type.get(), i->second);
+      }
+
     return true;
   }
 
@@ -1246,6 +1510,7 @@ public:
       }
 
     perform_late_type_canonicalizing();
+    get_environment().clear_canonical_type_hints();
 
     if (do_log())
       {
@@ -1590,10 +1855,83 @@ advance_cursor(reader& rdr)
   return xmlTextReaderRead(reader.get());
 }
 
+/// A vector of pairs of type id and the XML node carrying it.
+typedef vector<std::pair<string, xmlNodePtr> > type_id_xml_node_vector;
+
+/// Walk an entire XML sub-tree to collect the value of the 'id'
+/// attributes of its element nodes, along with these nodes.
+///
+/// This doesn't touch the reader, so it can be run concurrently on
+/// distinct sub-trees.
+///
+/// @param node the XML sub-tree node to walk.
+///
+/// @param ids the vector where to add the collected ids and nodes,
+/// in document order.
+static void
+collect_type_ids_of_xml_node(xmlNodePtr node, type_id_xml_node_vector& ids)
+{
+  if (!node || node->type != XML_ELEMENT_NODE)
+    return;
+
+  if (xml_char_sptr s = XML_NODE_GET_ATTRIBUTE(node, "id"))
+    ids.push_back(std::make_pair(string(CHAR_STR(s)), node));
+
+  for (xmlNodePtr n = xmlFirstElementChild(node);
+       n;
+       n = xmlNextElementSibling(n))
+    collect_type_ids_of_xml_node(n, ids);
+}
+
+/// A task that collects the type ids of a range of sibling XML
+/// sub-trees.  See collect_type_ids_of_xml_node.
+class collect_type_ids_task : public workers::task
+{
+  vector<xmlNodePtr>::const_iterator	begin_;
+  vector<xmlNodePtr>::const_iterator	end_;
+  type_id_xml_node_vector		ids_;
+
+public:
+
+  /// Constructor of @ref collect_type_ids_task.
+  ///
+  /// @param begin the first sub-tree of the range.
+  ///
+  /// @param end the sub-tree past the end of the range.
+  collect_type_ids_task(vector<xmlNodePtr>::const_iterator begin,
+			vector<xmlNodePtr>::const_iterator end)
+    : begin_(begin),
+      end_(end)
+  {}
+
+  virtual void
+  perform()
+  {
+    for (auto i = begin_; i != end_; ++i)
+      collect_type_ids_of_xml_node(*i, ids_);
+  }
+
+  /// Getter of the ids collected by the task.
+  ///
+  /// @return the ids collected, in document order.
+  const type_id_xml_node_vector&
+  get_ids() const
+  {return ids_;}
+}; // end class collect_type_ids_task
+
 /// Walk an entire XML sub-tree to build a map where the key is the
 /// the value of the 'id' attribute (for type definitions) and the value
 /// is the xml node containing the 'id' attribute.
 ///
+/// For big sub-trees, like the one of an abi-corpus element, the
+/// sub-trees of the children of @p node are walked concurrently by
+/// at most fe_iface::options_type::nb_worker_threads worker threads.
+/// The ids they collect are then added to the map in document order,
+/// so the result is the same as with a sequential walk.
+///
+/// The worker threads are not used by default because tools like
+/// abipkgdiff already read several corpora concurrently.
+///
 /// @param rdr the context of the reader.
 ///
 /// @param node the XML sub-tree node to walk.  It must be an element
@@ -1602,19 +1940,57 @@ static void
 walk_xml_node_to_map_type_ids(reader& rdr,
 			      xmlNodePtr node)
 {
-  xmlNodePtr n = node;
-
-  if (!n || n->type != XML_ELEMENT_NODE)
+  if (!node || node->type != XML_ELEMENT_NODE)
     return;
 
-  if (xml_char_sptr s = XML_NODE_GET_ATTRIBUTE(n, "id"))
+  if (xml_char_sptr s = XML_NODE_GET_ATTRIBUTE(node, "id"))
     {
       string id = CHAR_STR(s);
-      rdr.map_id_and_node(id, n);
+      rdr.map_id_and_node(id, node);
     }
 
-  for (n = xmlFirstElementChild(n); n; n = xmlNextElementSibling(n))
-    walk_xml_node_to_map_type_ids(rdr, n);
+  vector<xmlNodePtr> children;
+  for (xmlNodePtr n = xmlFirstElementChild(node);
+       n;
+       n = xmlNextElementSibling(n))
+    children.push_back(n);
+
+  // Below that number of children per range, using worker threads
+  // is not worth it.
+  const size_t min_children_per_range = 64;
+  size_t nb_ranges =
+    std::min<size_t>(rdr.options().nb_worker_threads,
+		     children.size() / min_children_per_range);
+
+  if (nb_ranges <= 1)
+    {
+      type_id_xml_node_vector ids;
+      for (auto n : children)
+	collect_type_ids_of_xml_node(n, ids);
+      for (auto& i : ids)
+	rdr.map_id_and_node(i.first, i.second);
+      return;
+    }
+
+  workers::queue q(nb_ranges);
+
+  // Use more ranges than threads, as the sizes of the sub-trees vary
+  // a lot.
+  nb_ranges *= 4;
+  size_t range_size = (children.size() + nb_ranges - 1) / nb_ranges;
+  vector<std::shared_ptr<collect_type_ids_task> > tasks;
+  for (size_t b = 0; b < children.size(); b += range_size)
+    {
+      size_t e = std::min(b + range_size, children.size());
+      tasks.push_back(std::make_shared<collect_type_ids_task>
+		      (children.begin() + b, children.begin() + e));
+      q.schedule_task(tasks.back());
+    }
+  q.wait_for_workers_to_complete();
+
+  for (auto& t : tasks)
+    for (auto& i : t->get_ids())
+      rdr.map_id_and_node(i.first, i.second);
 }
 
 static bool
@@ -2016,6 +2392,29 @@ consider_types_not_reachable_from_public_interfaces(fe_iface& iface,
   rdr.tracking_non_reachable_types(flag);
 }
 
+/// Tell the @ref reader which canonical types the types of the
+/// abixml file are likely to have, given their type id.
+///
+/// This speeds up reading back an abixml file into the environment
+/// it was emitted from, like when checking that the serialization of
+/// a corpus into abixml doesn't lose information.  The types read
+/// from the file are then compared against the canonical types they
+/// were emitted from first, rather than against all the canonical
+/// types of the same name.  This doesn't change the resulting
+/// canonical types.  See environment::add_canonical_type_hint.
+///
+/// @param iface the @reader to consider.
+///
+/// @param hints the map of type ids and canonical types, as returned
+/// by xml_writer::get_canonical_types_of_type_ids.
+void
+set_canonical_type_hints(fe_iface& iface,
+			 unordered_map<string, type_base*> hints)
+{
+  abixml::reader& rdr = dynamic_cast<abixml::reader&>(iface);
+  rdr.canonical_type_hints(std::move(hints));
+}
+
 #ifdef WITH_SHOW_TYPE_USE_IN_ABILINT
 /// Get the vector of types that have a given type-id.
 ///
@@ -2029,10 +2428,7 @@ vector<type_base_sptr>*
 get_types_from_type_id(fe_iface& iface, const string& type_id)
 {
   xml_reader::reader& rdr = dynamic_cast<xml_reader::reader&>(iface);
-  auto it = rdr.m_types_map.find(type_id);
-  if (it == rdr.m_types_map.end())
-    return nullptr;
-  return &it->second;
+  return rdr.m_types_map.lookup(type_id);
 }
 
 /// Get the map that associates an artififact to its users.
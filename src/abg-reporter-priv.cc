@@ -1328,6 +1328,64 @@ show_linkage_name_and_aliases(ostream& out,
     out << ", aliases " << aliases;
 }
 
+/// Report the changes to the size, CRC, namespace or version of the
+/// symbols not referenced by any debug info, in a given @param
+/// corpus_diff.
+///
+/// @param d the corpus_diff to consider.
+///
+/// @param fn_syms if true, report about function symbols.
+/// Otherwise, report about variable symbols.
+///
+/// @param indent the indendation string (usually a string of white
+/// spaces) to use for indentation during the reporting.
+///
+/// @param out the output stream to emit the report to.
+void
+maybe_report_changed_unrefed_symbols(const corpus_diff& d,
+				     bool fn_syms,
+				     const string& indent,
+				     ostream& out)
+{
+  const diff_context_sptr& ctxt = d.context();
+  const string_changed_elf_symbol_map& changed_syms = fn_syms
+    ? d.changed_unrefed_function_symbols()
+    : d.changed_unrefed_variable_symbols();
+
+  if (!ctxt->show_symbols_unreferenced_by_debug_info()
+      || !ctxt->show_changed_symbols_unreferenced_by_debug_info()
+      || changed_syms.empty())
+    return;
+
+  const char* kind = fn_syms ? "function" : "variable";
+  if (changed_syms.size() == 1)
+    out << indent << "1 Changed " << kind
+	<< " symbol not referenced by debug info:\n\n";
+  else
+    out << indent << changed_syms.size() << " Changed " << kind
+	<< " symbols not referenced by debug info:\n\n";
+
+  vector<string> sorted_ids;
+  for (string_changed_elf_symbol_map::const_iterator i =
+	 changed_syms.begin();
+       i != changed_syms.end();
+       ++i)
+    sorted_ids.push_back(i->first);
+  std::sort(sorted_ids.begin(), sorted_ids.end());
+
+  for (vector<string>::const_iterator i = sorted_ids.begin();
+       i != sorted_ids.end();
+       ++i)
+    {
+      const std::pair<elf_symbol_sptr, elf_symbol_sptr>& p =
+	changed_syms.find(*i)->second;
+      out << indent << "  [C] " << *i << ":\n";
+      maybe_report_diff_for_symbol(p.first, p.second, ctxt,
+				   out, indent + "    ");
+    }
+  out << "\n";
+}
+
 /// Report changes about types that are not reachable from global
 /// functions and variables, in a given @param corpus_diff.
 ///
@@ -239,6 +239,12 @@ maybe_report_unreachable_type_changes(const corpus_diff& d,
 				      const string& indent,
 				      ostream& out);
 
+void
+maybe_report_changed_unrefed_symbols(const corpus_diff& d,
+				     bool fn_syms,
+				     const string& indent,
+				     ostream& out);
+
 void
 maybe_report_interfaces_impacted_by_diff(const diff		*d,
 					 ostream		&out,
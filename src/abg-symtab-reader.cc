@@ -11,6 +11,7 @@
 /// This contains the definition of the symtab reader
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <unordered_map>
 #include <unordered_set>
@@ -86,12 +87,52 @@ const elf_symbols&
 symtab::lookup_symbol(const std::string& name) const
 {
   static const elf_symbols empty_result;
-  const auto it = name_symbol_map_.find(name);
-  if (it != name_symbol_map_.end())
-      return it->second;
+  const auto it =
+    std::lower_bound(name_index_.begin(), name_index_.end(), name,
+		     [this](uint32_t i, const std::string& n)
+		     {return name_symbol_groups_[i].front()->get_name() < n;});
+  if (it != name_index_.end()
+      && name_symbol_groups_[*it].front()->get_name() == name)
+    return name_symbol_groups_[*it];
   return empty_result;
 }
 
+/// Find the first entry of the index which address is not less than
+/// a given address.
+///
+/// @param addr the address to look for.
+///
+/// @return the position of the entry found, or the size of the
+/// index.
+size_t
+symtab::addr_symbol_index_type::lower_bound(GElf_Addr addr) const
+{
+  return std::lower_bound(addrs.begin(), addrs.end(), addr) - addrs.begin();
+}
+
+/// Fill the index from an address -> symbol lookup map.
+///
+/// @param map the map to fill the index from.
+void
+symtab::addr_symbol_index_type::build(const addr_symbol_map_type& map)
+{
+  std::vector<std::pair<GElf_Addr, const elf_symbol_sptr*>> entries;
+  entries.reserve(map.size());
+  for (const auto& entry : map)
+    entries.push_back(std::make_pair(entry.first, &entry.second));
+  std::sort(entries.begin(), entries.end());
+
+  addrs.clear();
+  symbols.clear();
+  addrs.reserve(entries.size());
+  symbols.reserve(entries.size());
+  for (const auto& entry : entries)
+    {
+      addrs.push_back(entry.first);
+      symbols.push_back(*entry.second);
+    }
+}
+
 /// Lookup a symbol by its address
 ///
 /// @param symbol_addr the starting address of the symbol
@@ -101,20 +142,50 @@ const elf_symbol_sptr&
 symtab::lookup_symbol(GElf_Addr symbol_addr) const
 {
   static const elf_symbol_sptr empty_result;
-  const auto addr_it = addr_symbol_map_.find(symbol_addr);
-  if (addr_it != addr_symbol_map_.end())
-    return addr_it->second;
+  size_t i = addr_symbol_index_.lower_bound(symbol_addr);
+  if (i < addr_symbol_index_.addrs.size()
+      && addr_symbol_index_.addrs[i] == symbol_addr)
+    return addr_symbol_index_.symbols[i];
   else
     {
       // check for a potential entry address mapping instead,
       // relevant for ppc ELFv1 binaries
-      const auto entry_it = entry_addr_symbol_map_.find(symbol_addr);
-      if (entry_it != entry_addr_symbol_map_.end())
-	return entry_it->second;
+      i = entry_addr_symbol_index_.lower_bound(symbol_addr);
+      if (i < entry_addr_symbol_index_.addrs.size()
+	  && entry_addr_symbol_index_.addrs[i] == symbol_addr)
+	return entry_addr_symbol_index_.symbols[i];
     }
   return empty_result;
 }
 
+/// Hash a C string, using the FNV-1a algorithm.
+///
+/// @param s the string to hash.
+///
+/// @return the hash value of @p s.
+size_t
+symtab::c_string_hash::operator()(const char* s) const
+{
+  size_t h = 2166136261u;
+  for (; *s; ++s)
+    {
+      h ^= static_cast<unsigned char>(*s);
+      h *= 16777619u;
+    }
+  return h;
+}
+
+/// Test if two C strings are equal.
+///
+/// @param l the first string to consider.
+///
+/// @param r the second string to consider.
+///
+/// @return true iff @p l equals @p r.
+bool
+symtab::c_string_equal::operator()(const char* l, const char* r) const
+{return strcmp(l, r) == 0;}
+
 /// A symbol sorting functor.
 static struct
 {
@@ -263,9 +334,18 @@ symtab::load_(Elf*	       elf_handle,
     }
 
   const bool is_kernel = elf_helpers::is_linux_kernel(elf_handle);
-  std::unordered_set<std::string> exported_kernel_symbols;
-  std::unordered_map<std::string, uint32_t> crc_values;
-  std::unordered_map<std::string, std::string> namespaces;
+  // The ELF string tables stay mapped while the symbol table is being
+  // loaded, so the names below point into them rather than being
+  // copied.  A symbol name is only copied when its elf_symbol is
+  // created.
+  std::unordered_set<const char*, c_string_hash, c_string_equal>
+    exported_kernel_symbols;
+  std::unordered_map<const char*, uint32_t, c_string_hash, c_string_equal>
+    crc_values;
+  std::unordered_map<const char*, const char*, c_string_hash, c_string_equal>
+    namespaces;
+  std::vector<GElf_Sym> crc_symbols;
+  std::vector<const char*> crc_symbol_names;
 
   for (size_t i = 0; i < number_syms; ++i)
     {
@@ -278,15 +358,11 @@ symtab::load_(Elf*	       elf_handle,
 	  return false;
 	}
 
-      const char* const name_str =
+      const char* const name =
 	  elf_strptr(elf_handle, symtab_sheader.sh_link, sym->st_name);
 
       // no name, no game
-      if (!name_str)
-	continue;
-
-      const std::string name = name_str;
-      if (name.empty())
+      if (!name || !*name)
 	continue;
 
       // Handle ksymtab entries. Every symbol entry that starts with __ksymtab_
@@ -306,20 +382,19 @@ symtab::load_(Elf*	       elf_handle,
       // (seen so far for kernel modules and LTO builds). Hence we stick to the
       // fairly safe assumption that ksymtab exported entries are having an
       // appearence as __ksymtab_<symbol> in the symtab.
-      if (is_kernel && name.rfind("__ksymtab_", 0) == 0)
+      if (is_kernel && strncmp(name, "__ksymtab_", 10) == 0)
 	{
-	  ABG_ASSERT(exported_kernel_symbols.insert(name.substr(10)).second);
+	  ABG_ASSERT(exported_kernel_symbols.insert(name + 10).second);
 	  continue;
 	}
-      if (is_kernel && name.rfind("__crc_", 0) == 0)
+      if (is_kernel && strncmp(name, "__crc_", 6) == 0)
 	{
-	  uint32_t crc_value;
-	  ABG_ASSERT(elf_helpers::get_crc_for_symbol(elf_handle,
-						     sym, crc_value));
-	  ABG_ASSERT(crc_values.emplace(name.substr(6), crc_value).second);
+	  // The CRC values are read all at once, after this loop.
+	  crc_symbols.push_back(*sym);
+	  crc_symbol_names.push_back(name + 6);
 	  continue;
 	}
-      if (strings_section && is_kernel && name.rfind("__kstrtabns_", 0) == 0)
+      if (strings_section && is_kernel && strncmp(name, "__kstrtabns_", 12) == 0)
 	{
 	  // This symbol lives in the __ksymtab_strings section but st_value may
 	  // be a vmlinux load address so we need to subtract the offset before
@@ -336,8 +411,7 @@ symtab::load_(Elf*	       elf_handle,
 	  ABG_ASSERT(limit < last);
 	  // interpret the empty namespace name as no namespace name
 	  if (first < limit)
-	    ABG_ASSERT(namespaces.emplace(
-		name.substr(12), std::string(first, limit - first)).second);
+	    ABG_ASSERT(namespaces.emplace(name + 12, first).second);
 	  continue;
 	}
 
@@ -391,7 +465,7 @@ symtab::load_(Elf*	       elf_handle,
 	  if (common_sym_instances.size() > 1)
 	    {
 	      elf_symbol_sptr main_common_sym = common_sym_instances[0];
-	      ABG_ASSERT(main_common_sym->get_name() == name);
+	      ABG_ASSERT(main_common_sym->get_name() == symbol_sptr->get_name());
 	      ABG_ASSERT(main_common_sym->is_common_symbol());
 	      ABG_ASSERT(symbol_sptr.get() != main_common_sym.get());
 	      main_common_sym->add_common_instance(symbol_sptr);
@@ -403,6 +477,8 @@ symtab::load_(Elf*	       elf_handle,
 
   add_alternative_address_lookups(elf_handle);
 
+  build_address_indexes();
+
   is_kernel_binary_ = elf_helpers::is_linux_kernel(elf_handle);
 
   // Now apply the ksymtab_exported attribute to the symbols we collected.
@@ -418,7 +494,16 @@ symtab::load_(Elf*	       elf_handle,
       has_ksymtab_entries_ = true;
     }
 
-  // Now add the CRC values
+  // Now read and add the CRC values
+  if (!crc_symbols.empty())
+    {
+      std::vector<uint32_t> crcs;
+      ABG_ASSERT(elf_helpers::get_crcs_for_symbols(elf_handle,
+						   crc_symbols, crcs));
+      crc_values.reserve(crcs.size());
+      for (size_t i = 0; i < crcs.size(); ++i)
+	ABG_ASSERT(crc_values.emplace(crc_symbol_names[i], crcs[i]).second);
+    }
   for (const auto& crc_entry : crc_values)
     {
       const auto r = name_symbol_map_.find(crc_entry.first);
@@ -436,13 +521,16 @@ symtab::load_(Elf*	       elf_handle,
       if (r == name_symbol_map_.end())
 	continue;
 
+      const std::string ns = namespace_entry.second;
       for (const auto& symbol : r->second)
-	symbol->set_namespace(namespace_entry.second);
+	symbol->set_namespace(ns);
     }
 
   // sort the symbols for deterministic output
   std::sort(symbols_.begin(), symbols_.end(), symbol_sort);
 
+  build_name_index();
+
   return true;
 }
 
@@ -470,7 +558,8 @@ symtab::load_(string_elf_symbols_map_sptr function_symbol_map,
 	    if (!symbol->is_suppressed())
 	      symbols_.push_back(symbol);
 	  }
-	ABG_ASSERT(name_symbol_map_.insert(symbol_map_entry).second);
+	ABG_ASSERT(name_symbol_map_.emplace(symbol_map_entry.first.c_str(),
+					    symbol_map_entry.second).second);
       }
 
   if (variables_symbol_map)
@@ -481,12 +570,15 @@ symtab::load_(string_elf_symbols_map_sptr function_symbol_map,
 	    if (!symbol->is_suppressed())
 	      symbols_.push_back(symbol);
 	  }
-	ABG_ASSERT(name_symbol_map_.insert(symbol_map_entry).second);
+	ABG_ASSERT(name_symbol_map_.emplace(symbol_map_entry.first.c_str(),
+					    symbol_map_entry.second).second);
       }
 
   // sort the symbols for deterministic output
   std::sort(symbols_.begin(), symbols_.end(), symbol_sort);
 
+  build_name_index();
+
   return true;
 }
 
@@ -518,7 +610,19 @@ symtab::update_main_symbol(GElf_Addr addr, const std::string& name)
 
   // also update the default symbol we return when looked up by address
   if (new_main)
-    addr_symbol_map_[addr] = new_main;
+    {
+      size_t i = addr_symbol_index_.lower_bound(addr);
+      if (i < addr_symbol_index_.addrs.size()
+	  && addr_symbol_index_.addrs[i] == addr)
+	addr_symbol_index_.symbols[i] = new_main;
+      else
+	{
+	  addr_symbol_index_.addrs.insert
+	    (addr_symbol_index_.addrs.begin() + i, addr);
+	  addr_symbol_index_.symbols.insert
+	    (addr_symbol_index_.symbols.begin() + i, new_main);
+	}
+    }
 }
 
 /// Various adjustments and bookkeeping may be needed to provide a correct
@@ -703,26 +807,29 @@ symtab::add_alternative_address_lookups(Elf* elf_handle)
 	  continue;
 	}
 
-      const char* const name_str =
+      const char* const name =
 	  elf_strptr(elf_handle, symtab_sheader.sh_link, sym->st_name);
 
       // no name, no game
-      if (!name_str)
-	continue;
-
-      const std::string name = name_str;
-      if (name.empty())
+      if (!name || !*name)
 	continue;
 
       // Add alternative lookup addresses for CFI symbols
-      static const std::string cfi = ".cfi";
-      if (name.size() > cfi.size()
-	  && name.compare(name.size() - cfi.size(), cfi.size(), cfi) == 0)
+      static const char cfi[] = ".cfi";
+      static const size_t cfi_size = sizeof(cfi) - 1;
+      const size_t name_size = strlen(name);
+      if (name_size > cfi_size
+	  && strcmp(name + name_size - cfi_size, cfi) == 0)
 	// ... name.ends_with(".cfi")
 	{
-	  const auto candidate_name = name.substr(0, name.size() - cfi.size());
-
-	  auto symbols = lookup_symbol(candidate_name);
+	  const std::string candidate_name(name, name_size - cfi_size);
+
+	  // The name index is not built yet, so look the symbol up in
+	  // the name lookup map.
+	  const auto it = name_symbol_map_.find(candidate_name.c_str());
+	  static const elf_symbols empty_result;
+	  const elf_symbols& symbols =
+	    it == name_symbol_map_.end() ? empty_result : it->second;
           // lookup_symbol returns a vector of symbols. For this case we handle
           // only the case that there has been exactly one match. Otherwise we
           // can't reasonably handle it and need to bail out.
@@ -736,5 +843,53 @@ symtab::add_alternative_address_lookups(Elf* elf_handle)
     }
 }
 
+/// Build the sorted address -> symbol indexes from the lookup maps
+/// that were filled while loading the symbol table.
+///
+/// Once the symbol table is loaded, the symbols are only looked up
+/// by address, never inserted.  A vector sorted by address is more
+/// compact than a hash map and is binary-searched.  So the lookup
+/// maps are emptied and their memory is released.
+void
+symtab::build_address_indexes()
+{
+  addr_symbol_index_.build(addr_symbol_map_);
+  addr_symbol_map_type().swap(addr_symbol_map_);
+
+  entry_addr_symbol_index_.build(entry_addr_symbol_map_);
+  addr_symbol_map_type().swap(entry_addr_symbol_map_);
+}
+
+/// Build the sorted name -> symbols index from the lookup map that
+/// was filled while loading the symbol table.
+///
+/// The vectors of symbols of the lookup map are moved into
+/// name_symbol_groups_, and name_index_ is sorted by name.  The
+/// lookup map, which duplicates the symbol names, is emptied and its
+/// memory is released.
+void
+symtab::build_name_index()
+{
+  name_symbol_groups_.clear();
+  name_index_.clear();
+  name_symbol_groups_.reserve(name_symbol_map_.size());
+  name_index_.reserve(name_symbol_map_.size());
+  for (auto& entry : name_symbol_map_)
+    {
+      if (entry.second.empty())
+	continue;
+      name_index_.push_back(name_symbol_groups_.size());
+      name_symbol_groups_.push_back(std::move(entry.second));
+    }
+  name_symbol_map_type().swap(name_symbol_map_);
+
+  std::sort(name_index_.begin(), name_index_.end(),
+	    [this](uint32_t l, uint32_t r)
+	    {
+	      return (name_symbol_groups_[l].front()->get_name()
+		      < name_symbol_groups_[r].front()->get_name());
+	    });
+}
+
 } // end namespace symtab_reader
 } // end namespace abigail
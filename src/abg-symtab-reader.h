@@ -270,18 +270,79 @@ private:
   /// remember whether we ever saw ksymtab entries.
   bool has_ksymtab_entries_;
 
+  /// Hasher of a C string.
+  struct c_string_hash
+  {
+    size_t
+    operator()(const char* s) const;
+  };
+
+  /// Equality functor of C strings.
+  struct c_string_equal
+  {
+    bool
+    operator()(const char* l, const char* r) const;
+  };
+
   /// Lookup map name->symbol(s)
-  typedef std::unordered_map<std::string, std::vector<elf_symbol_sptr>>
+  ///
+  /// This is only used while loading the symbol table.  Its content
+  /// is then moved into name_symbol_groups_ and name_index_.
+  ///
+  /// The keys are not copies of the symbol names: they point into
+  /// the string table of the ELF file being loaded, or into the names
+  /// of the symbols themselves.
+  typedef std::unordered_map<const char*, std::vector<elf_symbol_sptr>,
+			     c_string_hash, c_string_equal>
 		       name_symbol_map_type;
   name_symbol_map_type name_symbol_map_;
 
+  /// The symbols, grouped by name.
+  std::vector<elf_symbols> name_symbol_groups_;
+
+  /// Indexes into name_symbol_groups_, sorted by symbol name.
+  /// Looking up symbols by name is a binary search in it.  Unlike
+  /// name_symbol_map_, this doesn't duplicate the names of the
+  /// symbols and has no per-entry allocation.
+  std::vector<uint32_t> name_index_;
+
   /// Lookup map addr->symbol
+  ///
+  /// This is only used while loading the symbol table, to detect
+  /// aliases.  At the end of the loading, its content is moved into
+  /// addr_symbol_index_.
   typedef std::unordered_map<GElf_Addr, elf_symbol_sptr> addr_symbol_map_type;
   addr_symbol_map_type addr_symbol_map_;
 
   /// Lookup map function entry address -> symbol
+  ///
+  /// Likewise, its content is moved into entry_addr_symbol_index_ at
+  /// the end of the loading.
   addr_symbol_map_type entry_addr_symbol_map_;
 
+  /// A sorted address -> symbol index.
+  ///
+  /// The addresses and the symbols are stored in two parallel
+  /// vectors, sorted by address.  Looking up a symbol by address is a
+  /// binary search in the dense vector of addresses.
+  struct addr_symbol_index_type
+  {
+    std::vector<GElf_Addr> addrs;
+    elf_symbols symbols;
+
+    size_t
+    lower_bound(GElf_Addr addr) const;
+
+    void
+    build(const addr_symbol_map_type& map);
+  };
+
+  /// Sorted index addr->symbol
+  addr_symbol_index_type addr_symbol_index_;
+
+  /// Sorted index function entry address -> symbol
+  addr_symbol_index_type entry_addr_symbol_index_;
+
   bool
   load_(Elf* elf_handle,
 	const ir::environment& env,
@@ -303,6 +364,12 @@ private:
 
   void
   add_alternative_address_lookups(Elf* elf_handle);
+
+  void
+  build_address_indexes();
+
+  void
+  build_name_index();
 };
 
 /// Helper class to allow range-for loops on symtabs for C++11 and later code.
@@ -27,12 +27,15 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/wait.h>
+#include <fcntl.h>
 #include <sys/time.h>
 #include <dirent.h>
 #include <time.h>
 #include <ctype.h>
 #include <errno.h>
 #include <libgen.h>
+#include <signal.h>
 
 #include <algorithm>
 #include <cstdlib>
@@ -41,9 +44,12 @@
 #include <iostream>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 
 #include "abg-dwarf-reader.h"
+#include "abg-elf-helpers.h"
 #ifdef WITH_CTF
 #include "abg-ctf-reader.h"
 #endif
@@ -59,6 +65,7 @@ ABG_BEGIN_EXPORT_DECLARATIONS
 #include <abg-ir.h>
 #include "abg-config.h"
 #include "abg-tools-utils.h"
+#include "abg-workers.h"
 
 ABG_END_EXPORT_DECLARATIONS
 // </headers defining libabigail's API>
@@ -352,6 +359,49 @@ file_exists(const string& path)
   return get_stat(path, &st);
 }
 
+/// Read a range of bytes of a file ahead of its use, so that it's in
+/// the page cache when it's eventually read.
+///
+/// This is meant to be invoked from worker threads, to overlap the
+/// I/O with some computation happening on the main thread.
+///
+/// @param path the path to the file to read.
+///
+/// @param offset the offset of the first byte of the range to read.
+///
+/// @param size the size of the range to read.  If it's zero, the
+/// file is read until its end.
+///
+/// @return the number of bytes actually read.
+uint64_t
+prefetch_file(const string& path, uint64_t offset, uint64_t size)
+{
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd == -1)
+    return 0;
+
+  if (size == 0)
+    {
+      struct stat s;
+      if (fstat(fd, &s) == 0 && (uint64_t) s.st_size > offset)
+	size = s.st_size - offset;
+    }
+
+  posix_fadvise(fd, offset, size, POSIX_FADV_SEQUENTIAL);
+  uint64_t bytes_read = 0;
+  char buf[64 * 1024];
+  while (bytes_read < size)
+    {
+      size_t to_read = std::min<uint64_t>(sizeof(buf), size - bytes_read);
+      ssize_t n = pread(fd, buf, to_read, offset + bytes_read);
+      if (n <= 0)
+	break;
+      bytes_read += n;
+    }
+  close(fd);
+  return bytes_read;
+}
+
 /// Test that a given directory exists.
 ///
 /// @param path the path of the directory to consider.
@@ -425,7 +475,122 @@ dir_contains_ctf_archive(const string& directory,
   return false;
 }
 
-/// Test if an ELF file has DWARF debug info.
+// <debug info probes cache>
+
+/// The results of the probes of ELF files for debug info, made by
+/// the file_has_*_debug_info functions.
+///
+/// Tools like abipkgdiff probe a given binary for several kinds of
+/// debug info before choosing the front-end to read it with.  Each
+/// probe opens the binary and, for DWARF, has libdw decompress its
+/// compressed debug sections.  The results of the probes are thus
+/// kept here for the duration of the tool run, so that a binary is
+/// probed at most once for a given kind of debug info.
+///
+/// The key of the map is built by get_debug_info_probe_key.  Its
+/// value is a bit mask made of two bits per kind of debug info: the
+/// first one tells if the binary was probed, the second one is the
+/// result of the probe.
+static std::unordered_map<string, unsigned> debug_info_probes;
+
+/// The counters about the probes of ELF files for debug info.
+static debug_info_probe_stats debug_info_probes_stats;
+
+/// The lock protecting debug_info_probes and debug_info_probes_stats,
+/// as binaries are probed from worker threads by abipkgdiff.
+static std::mutex debug_info_probes_lock;
+
+/// The kinds of debug info binaries are probed for.
+enum debug_info_probe_kind
+{
+  DWARF_DEBUG_INFO_PROBE = 0,
+  CTF_DEBUG_INFO_PROBE = 1,
+  BTF_DEBUG_INFO_PROBE = 2
+};
+
+/// Build the key under which the results of the probes of an ELF
+/// file for debug info are cached.
+///
+/// The file is identified by its device, inode, size and time of
+/// last modification, so that a file that is replaced during the
+/// tool run is probed again.
+///
+/// @param elf_file_path the path to the ELF file to consider.
+///
+/// @param debug_info_root_paths the directories where to look for
+/// the debug info of @p elf_file_path.
+///
+/// @param key output parameter.  This is set to the resulting key.
+///
+/// @return true iff the key could be built.
+static bool
+get_debug_info_probe_key(const string& elf_file_path,
+			 const vector<char**>& debug_info_root_paths,
+			 string& key)
+{
+  DECLARE_STAT(st);
+  if (stat(elf_file_path.c_str(), &st) != 0)
+    return false;
+
+  std::ostringstream o;
+  o << st.st_dev << ':' << st.st_ino << ':' << st.st_size
+    << ':' << st.st_mtime;
+  for (const auto& path : debug_info_root_paths)
+    if (path && *path)
+      o << ':' << *path;
+  key = o.str();
+  return true;
+}
+
+/// Probe an ELF file for a given kind of debug info, unless it has
+/// already been probed for it.
+///
+/// @param elf_file_path the path to the ELF file to consider.
+///
+/// @param debug_info_root_paths the directories where to look for
+/// the debug info of @p elf_file_path.
+///
+/// @param kind the kind of debug info to probe for.
+///
+/// @param probe the function that probes @p elf_file_path for
+/// debug info of kind @p kind.
+///
+/// @return true iff @p elf_file_path has debug info of kind @p kind.
+static bool
+probe_debug_info(const string& elf_file_path,
+		 const vector<char**>& debug_info_root_paths,
+		 debug_info_probe_kind kind,
+		 bool (*probe)(const string&, const vector<char**>&))
+{
+  const unsigned probed_bit = 1u << (2 * kind);
+  const unsigned result_bit = probed_bit << 1;
+
+  string key;
+  bool is_cacheable = get_debug_info_probe_key(elf_file_path,
+					       debug_info_root_paths,
+					       key);
+  if (is_cacheable)
+    {
+      std::lock_guard<std::mutex> lock(debug_info_probes_lock);
+      auto i = debug_info_probes.find(key);
+      if (i != debug_info_probes.end() && (i->second & probed_bit))
+	{
+	  ++debug_info_probes_stats.nb_cached_probes;
+	  return i->second & result_bit;
+	}
+    }
+
+  bool result = probe(elf_file_path, debug_info_root_paths);
+
+  std::lock_guard<std::mutex> lock(debug_info_probes_lock);
+  ++debug_info_probes_stats.nb_probes;
+  if (is_cacheable)
+    debug_info_probes[key] |= probed_bit | (result ? result_bit : 0);
+
+  return result;
+}
+
+/// Probe an ELF file for DWARF debug info.
 ///
 /// This function supports split debug info files as well.
 ///
@@ -439,9 +604,9 @@ dir_contains_ctf_archive(const string& directory,
 ///
 /// @return true iff the ELF file at @elf_file_path is an ELF file
 /// that contains debug info.
-bool
-file_has_dwarf_debug_info(const string& elf_file_path,
-			  const vector<char**>& debug_info_root_paths)
+static bool
+probe_dwarf_debug_info(const string& elf_file_path,
+		       const vector<char**>& debug_info_root_paths)
 {
   if (guess_file_type(elf_file_path) != FILE_TYPE_ELF)
     return false;
@@ -451,13 +616,22 @@ file_has_dwarf_debug_info(const string& elf_file_path,
 		debug_info_root_paths,
 		env);
 
-  if (r.dwarf_debug_info())
-    return true;
+  uint64_t decompressed_bytes = 0;
+  if (Elf* elf_handle = r.elf_handle())
+    decompressed_bytes =
+      elf_helpers::get_decompressed_size_of_debug_sections(elf_handle);
 
-  return false;
+  bool result = r.dwarf_debug_info();
+  if (decompressed_bytes)
+    {
+      std::lock_guard<std::mutex> lock(debug_info_probes_lock);
+      debug_info_probes_stats.nb_decompressed_bytes += decompressed_bytes;
+    }
+
+  return result;
 }
 
-/// Test if an ELF file has CTF debug info.
+/// Probe an ELF file for CTF debug info.
 ///
 /// This function supports split debug info files as well.
 /// Linux Kernel with CTF debug information generates a CTF archive:
@@ -475,9 +649,9 @@ file_has_dwarf_debug_info(const string& elf_file_path,
 ///
 /// @return true iff the ELF file at @elf_file_path is an ELF file
 /// that contains debug info.
-bool
-file_has_ctf_debug_info(const string& elf_file_path,
-			const vector<char**>& debug_info_root_paths)
+static bool
+probe_ctf_debug_info(const string& elf_file_path,
+		     const vector<char**>& debug_info_root_paths)
 {
   if (guess_file_type(elf_file_path) != FILE_TYPE_ELF)
     return false;
@@ -507,7 +681,7 @@ file_has_ctf_debug_info(const string& elf_file_path,
   return false;
 }
 
-/// Test if an ELF file has BTFG debug info.
+/// Probe an ELF file for BTF debug info.
 ///
 /// @param elf_file_path the path to the ELF file to consider.
 ///
@@ -519,11 +693,11 @@ file_has_ctf_debug_info(const string& elf_file_path,
 ///
 /// @return true iff the ELF file at @elf_file_path is an ELF file
 /// that contains debug info.
-bool
-file_has_btf_debug_info(const string& elf_file_path,
-			const vector<char**>& debug_info_root_paths)
+static bool
+probe_btf_debug_info(const string& elf_file_path,
+		     const vector<char**>& debug_info_root_paths)
 {
-    if (guess_file_type(elf_file_path) != FILE_TYPE_ELF)
+  if (guess_file_type(elf_file_path) != FILE_TYPE_ELF)
     return false;
 
   environment env;
@@ -535,6 +709,88 @@ file_has_btf_debug_info(const string& elf_file_path,
   return false;
 }
 
+/// Test if an ELF file has DWARF debug info.
+///
+/// This function supports split debug info files as well.
+///
+/// The result is cached for the duration of the tool run, so the ELF
+/// file is probed at most once.
+///
+/// @param elf_file_path the path to the ELF file to consider.
+///
+/// @param debug_info_root a vector of pointer to directory to look
+/// for debug info, in case the file is associated to split debug
+/// info.  If there is no split debug info then this vector can be
+/// empty.  Note that convert_char_stars_to_char_star_stars() can be
+/// used to ease the construction of this vector.
+///
+/// @return true iff the ELF file at @elf_file_path is an ELF file
+/// that contains debug info.
+bool
+file_has_dwarf_debug_info(const string& elf_file_path,
+			  const vector<char**>& debug_info_root_paths)
+{
+  return probe_debug_info(elf_file_path, debug_info_root_paths,
+			  DWARF_DEBUG_INFO_PROBE, probe_dwarf_debug_info);
+}
+
+/// Test if an ELF file has CTF debug info.
+///
+/// The result is cached for the duration of the tool run, so the ELF
+/// file is probed at most once.
+///
+/// @param elf_file_path the path to the ELF file to consider.
+///
+/// @param debug_info_root a vector of pointer to directory to look
+/// for debug info, in case the file is associated to split debug
+/// info.  If there is no split debug info then this vector can be
+/// empty.
+///
+/// @return true iff the ELF file at @elf_file_path is an ELF file
+/// that contains debug info.
+bool
+file_has_ctf_debug_info(const string& elf_file_path,
+			const vector<char**>& debug_info_root_paths)
+{
+  return probe_debug_info(elf_file_path, debug_info_root_paths,
+			  CTF_DEBUG_INFO_PROBE, probe_ctf_debug_info);
+}
+
+/// Test if an ELF file has BTF debug info.
+///
+/// The result is cached for the duration of the tool run, so the ELF
+/// file is probed at most once.
+///
+/// @param elf_file_path the path to the ELF file to consider.
+///
+/// @param debug_info_root a vector of pointer to directory to look
+/// for debug info, in case the file is associated to split debug
+/// info.  If there is no split debug info then this vector can be
+/// empty.
+///
+/// @return true iff the ELF file at @elf_file_path is an ELF file
+/// that contains debug info.
+bool
+file_has_btf_debug_info(const string& elf_file_path,
+			const vector<char**>& debug_info_root_paths)
+{
+  return probe_debug_info(elf_file_path, debug_info_root_paths,
+			  BTF_DEBUG_INFO_PROBE, probe_btf_debug_info);
+}
+
+/// Get the counters about the probes of ELF files for debug info
+/// made by the file_has_*_debug_info functions.
+///
+/// @return the counters.
+debug_info_probe_stats
+get_debug_info_probe_stats()
+{
+  std::lock_guard<std::mutex> lock(debug_info_probes_lock);
+  return debug_info_probes_stats;
+}
+
+// </debug info probes cache>
+
 /// Tests if a given path is a directory or a symbolic link to a
 /// directory.
 ///
@@ -865,6 +1121,36 @@ emit_prefix(const string& prog_name, ostream& out)
   return out;
 }
 
+/// Emit a report of the approximate memory used by some internal
+/// data structures.
+///
+/// Each entry of the report is emitted on its own line, prefixed by
+/// the name of the program.  A last line emits the sum of the sizes
+/// of all the entries.
+///
+/// @param prog_name the name of the program to use in the prefix.
+///
+/// @param usage the memory usage entries to emit.
+///
+/// @param out the output stream where to emit the report.
+void
+emit_memory_usage(const string& prog_name,
+		  const ir::memory_usage_vector& usage,
+		  ostream& out)
+{
+  uint64_t total = 0;
+  for (const auto& u : usage)
+    {
+      emit_prefix(prog_name, out)
+	<< u.name << ": " << u.count << " entries, "
+	<< (u.bytes + 1023) / 1024 << " KB\n";
+      total += u.bytes;
+    }
+  emit_prefix(prog_name, out)
+    << "approximate memory used: "
+    << (total + 1024 * 1024 - 1) / (1024 * 1024) << " MB\n";
+}
+
 /// Check if a given path exists and is readable.
 ///
 /// @param path the path to consider.
@@ -1621,8 +1907,38 @@ guess_file_type(istream& in)
   return FILE_TYPE_UNKNOWN;
 }
 
+/// Test if the name of a file is that of a compressed abixml file.
+///
+/// That is the case if the name ends with ".abi" or ".xml", followed
+/// by the extension of one of the compression schemes of @ref
+/// compression_kind.
+///
+/// @param file_path the path to the file to consider.
+///
+/// @return true iff @p file_path is the name of a compressed abixml
+/// file.
+static bool
+is_compressed_abixml_file_name(const string& file_path)
+{
+  static const char* const compression_extensions[] = {".gz", ".xz", ".zst"};
+  for (const char* extension : compression_extensions)
+    if (string_ends_with(file_path, extension))
+      {
+	string name = file_path.substr(0, file_path.size()
+				       - strlen(extension));
+	return (string_ends_with(name, ".abi")
+		|| string_ends_with(name, ".xml"));
+      }
+  return false;
+}
+
 /// Guess the type of the content of an file.
 ///
+/// The content of a compressed file is only looked at if the name of
+/// the file says it's a compressed abixml file, e.g, "foo.abi.xz".
+/// This avoids starting a decompression process for each of the
+/// compressed files of a package, which are not abixml files.
+///
 /// @param file_path the path to the file to consider.
 ///
 /// @return the type of content guessed.
@@ -1649,12 +1965,303 @@ guess_file_type(const string& file_path)
       || string_ends_with(file_path, ".tz"))
     return FILE_TYPE_TAR;
 
+  compression_kind compression = COMPRESSION_NONE;
+  if (is_compressed_abixml_file_name(file_path))
+    compression = guess_compression_kind(file_path);
+  if (compression != COMPRESSION_NONE)
+    {
+      // Look at the beginning of the decompressed content.  Only
+      // abixml files are read transparently from a compressed file,
+      // so these are the only types we report for them.
+      pid_t pid = 0;
+      int fd = open_decompressed_file(file_path, compression, pid);
+      if (fd < 0)
+	return FILE_TYPE_UNKNOWN;
+
+      const size_t BUF_LEN = 263;
+      char buf[BUF_LEN];
+      size_t len = 0;
+      while (len < BUF_LEN)
+	{
+	  ssize_t n = read(fd, buf + len, BUF_LEN - len);
+	  if (n < 0 && errno == EINTR)
+	    continue;
+	  if (n <= 0)
+	    break;
+	  len += n;
+	}
+      close(fd);
+      wait_for_compression_process(pid);
+
+      std::istringstream in(string(buf, len));
+      file_type r = guess_file_type(in);
+      if (r == FILE_TYPE_NATIVE_BI
+	  || r == FILE_TYPE_XML_CORPUS
+	  || r == FILE_TYPE_XML_CORPUS_GROUP)
+	return r;
+      return FILE_TYPE_UNKNOWN;
+    }
+
   ifstream in(file_path.c_str(), ifstream::binary);
   file_type r = guess_file_type(in);
   in.close();
   return r;
 }
 
+/// Guess the compression scheme of a file by looking at its first
+/// bytes.
+///
+/// @param file_path the path to the file to consider.
+///
+/// @return the compression scheme of the file, or COMPRESSION_NONE
+/// if the file is not compressed or could not be read.
+compression_kind
+guess_compression_kind(const string& file_path)
+{
+  unsigned char buf[6] = {0, 0, 0, 0, 0, 0};
+  int fd = open(file_path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return COMPRESSION_NONE;
+  ssize_t len = read(fd, buf, sizeof(buf));
+  close(fd);
+
+  if (len >= 2 && buf[0] == 0x1f && buf[1] == 0x8b)
+    return COMPRESSION_GZIP;
+
+  if (len >= 6
+      && buf[0] == 0xfd
+      && buf[1] == '7'
+      && buf[2] == 'z'
+      && buf[3] == 'X'
+      && buf[4] == 'Z'
+      && buf[5] == 0x00)
+    return COMPRESSION_XZ;
+
+  if (len >= 4
+      && buf[0] == 0x28
+      && buf[1] == 0xb5
+      && buf[2] == 0x2f
+      && buf[3] == 0xfd)
+    return COMPRESSION_ZSTD;
+
+  return COMPRESSION_NONE;
+}
+
+/// Deduce the compression scheme to use for an output file from the
+/// extension of its name.
+///
+/// @param file_path the path to the file to consider.
+///
+/// @return the compression scheme to use for @p file_path.
+compression_kind
+get_compression_kind_from_file_name(const string& file_path)
+{
+  if (string_ends_with(file_path, ".gz"))
+    return COMPRESSION_GZIP;
+  if (string_ends_with(file_path, ".xz"))
+    return COMPRESSION_XZ;
+  if (string_ends_with(file_path, ".zst"))
+    return COMPRESSION_ZSTD;
+  return COMPRESSION_NONE;
+}
+
+/// Start a process running the (de)compression program for a given
+/// compression scheme, with one end of a pipe connected to it.
+///
+/// @param kind the compression scheme to consider.
+///
+/// @param decompress if true, the process decompresses the content
+/// of @p file_fd and writes it to the pipe.  Otherwise, it
+/// compresses what is written to the pipe into @p file_fd.
+///
+/// @param file_fd the file descriptor of the compressed file.
+///
+/// @param pid output parameter.  This is set to the process id of
+/// the new process iff the function succeeds.
+///
+/// @return the file descriptor of the end of the pipe to read from
+/// (if @p decompress is true) or to write to, or -1 if the process
+/// could not be started or if the program could not be executed.
+static int
+start_compression_process(compression_kind kind,
+			  bool decompress,
+			  int file_fd,
+			  pid_t& pid)
+{
+  const char* program = 0;
+  switch (kind)
+    {
+    case COMPRESSION_NONE:
+      return -1;
+    case COMPRESSION_GZIP:
+      program = "gzip";
+      break;
+    case COMPRESSION_XZ:
+      program = "xz";
+      break;
+    case COMPRESSION_ZSTD:
+      program = "zstd";
+      break;
+    }
+
+  // Both pipes are created close-on-exec, so that they don't leak
+  // into the program, nor into the other child processes.
+  int fds[2];
+  if (pipe2(fds, O_CLOEXEC) != 0)
+    return -1;
+
+  // The child process reports the failure to execute the program
+  // through this pipe.  If the program gets executed, the pipe is
+  // just closed.
+  int status_fds[2];
+  if (pipe2(status_fds, O_CLOEXEC) != 0)
+    {
+      close(fds[0]);
+      close(fds[1]);
+      return -1;
+    }
+
+  int our_end = decompress ? fds[0] : fds[1];
+  int their_end = decompress ? fds[1] : fds[0];
+
+  pid = fork();
+  if (pid < 0)
+    {
+      close(fds[0]);
+      close(fds[1]);
+      close(status_fds[0]);
+      close(status_fds[1]);
+      return -1;
+    }
+
+  if (pid == 0)
+    {
+      // This is the child process.  The program must be killed by
+      // SIGPIPE if its reader goes away, even if we ignore or block
+      // that signal.
+      signal(SIGPIPE, SIG_DFL);
+      sigset_t sigpipe_set;
+      sigemptyset(&sigpipe_set);
+      sigaddset(&sigpipe_set, SIGPIPE);
+      sigprocmask(SIG_UNBLOCK, &sigpipe_set, 0);
+
+      if (dup2(decompress ? file_fd : their_end, STDIN_FILENO) >= 0
+	  && dup2(decompress ? their_end : file_fd, STDOUT_FILENO) >= 0)
+	{
+	  if (decompress)
+	    execlp(program, program, "-d", "-c", "-q", (char*) 0);
+	  else
+	    execlp(program, program, "-c", "-q", (char*) 0);
+	}
+      int error = errno;
+      while (write(status_fds[1], &error, sizeof(error)) < 0
+	     && errno == EINTR)
+	;
+      _exit(127);
+    }
+
+  close(their_end);
+  close(status_fds[1]);
+
+  // Wait for the program to be executed, or for the child process
+  // to report why it couldn't be.
+  int error = 0;
+  ssize_t n;
+  do
+    n = read(status_fds[0], &error, sizeof(error));
+  while (n < 0 && errno == EINTR);
+  close(status_fds[0]);
+
+  if (n != 0)
+    {
+      close(our_end);
+      wait_for_compression_process(pid);
+      return -1;
+    }
+
+  return our_end;
+}
+
+/// Open a compressed file for reading its decompressed content.
+///
+/// The file is decompressed on the fly by a child process running the
+/// decompression program of @p kind, without being staged anywhere.
+/// Once done reading, the returned file descriptor must be closed
+/// and the child process be waited for with
+/// wait_for_compression_process.
+///
+/// @param file_path the path to the compressed file.
+///
+/// @param kind the compression scheme of the file.
+///
+/// @param pid output parameter.  This is set to the process id of
+/// the decompression process iff the function succeeds.
+///
+/// @return a file descriptor to read the decompressed content from,
+/// or -1 if an error occurred.
+int
+open_decompressed_file(const string& file_path,
+		       compression_kind kind,
+		       pid_t& pid)
+{
+  int file_fd = open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file_fd < 0)
+    return -1;
+  int fd = start_compression_process(kind, /*decompress=*/true,
+				     file_fd, pid);
+  close(file_fd);
+  return fd;
+}
+
+/// Create a compressed file, for writing its content uncompressed.
+///
+/// What is written to the returned file descriptor is compressed on
+/// the fly into the file by a child process running the compression
+/// program of @p kind.  Once done writing, the returned file
+/// descriptor must be closed and the child process be waited for
+/// with wait_for_compression_process.
+///
+/// @param file_path the path to the compressed file to create.  If
+/// the file exists, it's truncated.
+///
+/// @param kind the compression scheme to use.
+///
+/// @param pid output parameter.  This is set to the process id of
+/// the compression process iff the function succeeds.
+///
+/// @return a file descriptor to write the uncompressed content to,
+/// or -1 if an error occurred.
+int
+open_compressed_output_file(const string& file_path,
+			    compression_kind kind,
+			    pid_t& pid)
+{
+  int file_fd = open(file_path.c_str(),
+		     O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+  if (file_fd < 0)
+    return -1;
+  int fd = start_compression_process(kind, /*decompress=*/false,
+				     file_fd, pid);
+  close(file_fd);
+  return fd;
+}
+
+/// Wait for a process started by open_decompressed_file or
+/// open_compressed_output_file to terminate.
+///
+/// @param pid the process id of the process to wait for.
+///
+/// @return true iff the process terminated successfully.
+bool
+wait_for_compression_process(pid_t pid)
+{
+  int status = 0;
+  while (waitpid(pid, &status, 0) < 0)
+    if (errno != EINTR)
+      return false;
+  return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
 /// Get the package name of a .deb package.
 ///
 /// @param str the string containing the .deb NVR.
@@ -2687,6 +3294,23 @@ get_binary_paths_from_kernel_dist(const string&	dist_root,
 					   module_paths);
 }
 
+/// A task that reads a file ahead of its use, so that it's in the
+/// page cache when it's eventually read.
+class file_prefetch_task : public abigail::workers::task
+{
+  string path_;
+
+public:
+
+  file_prefetch_task(const string& path)
+    : path_(path)
+  {}
+
+  virtual void
+  perform()
+  {prefetch_file(path_);}
+}; // end class file_prefetch_task
+
 /// It builds a @ref corpus_group made of vmlinux kernel file and
 /// the kernel modules found under @p root directory and under its
 /// sub-directories, recursively.
@@ -2755,6 +3379,26 @@ load_vmlinux_corpus(elf_based_reader_sptr rdr,
 
   rdr->corpus_group(group);
 
+  // Read the module binaries ahead of their processing, on worker
+  // threads, so that the I/O overlaps with the construction of the IR
+  // of the binaries being processed.  Only a window of modules is
+  // read ahead so as not to thrash the page cache.  The IR of the
+  // modules is still built serially, in the order of the modules
+  // vector, as the environment is not meant to be used concurrently.
+  const size_t nb_threads = abigail::workers::get_number_of_threads();
+  const size_t prefetch_window = 2 * nb_threads;
+  abigail::workers::queue prefetch_queue(nb_threads);
+  size_t nb_prefetched_modules = 0;
+  auto prefetch_modules_until = [&](size_t end)
+  {
+    for (; nb_prefetched_modules < std::min(end, modules.size());
+	 ++nb_prefetched_modules)
+      prefetch_queue.schedule_task
+	(std::make_shared<file_prefetch_task>
+	 (modules[nb_prefetched_modules]));
+  };
+  prefetch_modules_until(prefetch_window);
+
   if (verbose)
     std::cerr << "reading kernel binary '"
      << vmlinux << "' ...\n" << std::flush;
@@ -2786,6 +3430,8 @@ load_vmlinux_corpus(elf_based_reader_sptr rdr,
          << "/" << total_nb_modules
          << ") ... " << std::flush;
 
+      prefetch_modules_until(cur_module_index + prefetch_window);
+
       rdr->initialize(*m, di_roots,
                       /*read_all_types=*/false,
                       /*linux_kernel_mode=*/true);
@@ -2804,6 +3450,8 @@ load_vmlinux_corpus(elf_based_reader_sptr rdr,
          << "' reading DONE: "
          << t << "\n";
     }
+
+  prefetch_queue.wait_for_workers_to_complete();
 }
 
 /// Walk a given directory and build an instance of @ref corpus_group
@@ -12,6 +12,14 @@
 
 #include "config.h"
 #include <assert.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
 #include <algorithm>
 #include <fstream>
 #include <iomanip>
@@ -85,10 +93,8 @@ public:
   interned_string
   get_id() const
   {
-    ostringstream o;
-    o << get_new_id();
     const environment& env = get_environment();
-    return env.intern(o.str());
+    return env.intern(std::to_string(get_new_id()));
   }
 
   /// Return a unique string representing a numerical ID, prefixed by
@@ -98,10 +104,12 @@ public:
   interned_string
   get_id_with_prefix(const string& prefix) const
   {
-    ostringstream o;
-    o << prefix << get_new_id();
+    // This is called once per emitted type, so build the id in place
+    // rather than going through a string stream.
+    string id = prefix;
+    id += std::to_string(get_new_id());
     const environment& env = get_environment();
-    return env.intern(o.str());
+    return env.intern(id);
   }
 };
 
@@ -199,6 +207,179 @@ typedef unordered_map<shared_ptr<function_tdecl>,
 		      string,
 		      function_tdecl::shared_ptr_hash> fn_tmpl_shared_ptr_map;
 
+/// A stream buffer that writes to a file descriptor.
+///
+/// The abixml writer emits its output through a myriad of small
+/// insertions into an ostream.  When the ostream is backed by this
+/// buffer, these insertions are accumulated into a large contiguous
+/// buffer that is handed over to write(2) only when it's full, or
+/// when the stream is flushed.
+class fd_streambuf : public std::streambuf
+{
+  int			m_fd;
+  bool			m_owns_fd;
+  bool			m_failed;
+  unsigned long long	m_nb_bytes_written;
+  vector<char>		m_buffer;
+
+  fd_streambuf();
+
+  /// Write a chunk of memory to the file descriptor.
+  ///
+  /// The file descriptor can be a pipe to a compression process.  If
+  /// that process is gone, writing to the pipe raises SIGPIPE, which
+  /// would kill the whole program.  So SIGPIPE is blocked while
+  /// writing, the write then fails with EPIPE, and the pending
+  /// SIGPIPE is discarded.
+  ///
+  /// @param data the start of the memory chunk to write.
+  ///
+  /// @param size the size of the memory chunk to write.
+  ///
+  /// @return true iff the chunk was completely written.
+  bool
+  write_to_fd(const char* data, size_t size)
+  {
+    sigset_t sigpipe_set, pending_set, old_set;
+    sigemptyset(&sigpipe_set);
+    sigaddset(&sigpipe_set, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &sigpipe_set, &old_set);
+    // A SIGPIPE that was pending before is not ours to discard.
+    sigpending(&pending_set);
+    bool sigpipe_was_pending = sigismember(&pending_set, SIGPIPE);
+
+    bool got_epipe = false;
+    while (size && !m_failed)
+      {
+	ssize_t n = ::write(m_fd, data, size);
+	if (n < 0)
+	  {
+	    if (errno == EINTR)
+	      continue;
+	    got_epipe = (errno == EPIPE);
+	    m_failed = true;
+	    break;
+	  }
+	data += n;
+	size -= n;
+	m_nb_bytes_written += n;
+      }
+
+    if (got_epipe && !sigpipe_was_pending)
+      {
+	struct timespec no_wait = {0, 0};
+	while (sigtimedwait(&sigpipe_set, 0, &no_wait) < 0
+	       && errno == EINTR)
+	  ;
+      }
+    pthread_sigmask(SIG_SETMASK, &old_set, 0);
+
+    return !m_failed;
+  }
+
+  /// Write the content of the buffer to the file descriptor and
+  /// reset the buffer.
+  ///
+  /// @return true iff the content of the buffer was completely
+  /// written.
+  bool
+  flush_buffer()
+  {
+    bool ok = write_to_fd(pbase(), pptr() - pbase());
+    setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+    return ok;
+  }
+
+protected:
+
+  virtual int_type
+  overflow(int_type c)
+  {
+    if (!flush_buffer())
+      return traits_type::eof();
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+      {
+	*pptr() = traits_type::to_char_type(c);
+	pbump(1);
+      }
+    return traits_type::not_eof(c);
+  }
+
+  virtual std::streamsize
+  xsputn(const char* s, std::streamsize n)
+  {
+    if (n <= epptr() - pptr())
+      {
+	memcpy(pptr(), s, n);
+	pbump(n);
+	return n;
+      }
+
+    if (!flush_buffer())
+      return 0;
+
+    if (static_cast<size_t>(n) >= m_buffer.size())
+      // This chunk wouldn't fit in the buffer anyway, so write it
+      // directly.
+      return write_to_fd(s, n) ? n : 0;
+
+    memcpy(pptr(), s, n);
+    pbump(n);
+    return n;
+  }
+
+  virtual int
+  sync()
+  {return flush_buffer() ? 0 : -1;}
+
+public:
+
+  /// The default size of the buffer.
+  static const size_t default_buffer_size = 1024 * 1024;
+
+  /// Constructor.
+  ///
+  /// @param fd the file descriptor to write to.
+  ///
+  /// @param owns_fd if true, then @p fd is closed when this buffer is
+  /// destroyed.
+  fd_streambuf(int fd, bool owns_fd)
+    : m_fd(fd),
+      m_owns_fd(owns_fd),
+      m_failed(false),
+      m_nb_bytes_written(0),
+      m_buffer(default_buffer_size)
+  {setp(m_buffer.data(), m_buffer.data() + m_buffer.size());}
+
+  ~fd_streambuf()
+  {close();}
+
+  /// Flush the buffer and, if this buffer owns the file descriptor,
+  /// close it.
+  ///
+  /// @return true iff all the output could be written out.
+  bool
+  close()
+  {
+    if (m_fd < 0)
+      return !m_failed;
+
+    flush_buffer();
+    if (m_owns_fd && ::close(m_fd) != 0)
+      m_failed = true;
+    m_fd = -1;
+    return !m_failed;
+  }
+
+  /// Getter of the number of bytes written to the file descriptor so
+  /// far.
+  ///
+  /// @return the number of bytes written so far.
+  unsigned long long
+  get_nb_bytes_written() const
+  {return m_nb_bytes_written;}
+}; // end class fd_streambuf
+
 typedef unordered_map<shared_ptr<class_tdecl>,
 		      string,
 		      class_tdecl::shared_ptr_hash> class_tmpl_shared_ptr_map;
@@ -208,6 +389,13 @@ class write_context
   const environment&			m_env;
   id_manager				m_id_manager;
   ostream*				m_ostream;
+  // The buffer and stream used when writing to a file descriptor.
+  std::unique_ptr<fd_streambuf>		m_fd_streambuf;
+  std::unique_ptr<ostream>		m_fd_ostream;
+  ostream*				m_ostream_before_fd;
+  // The process compressing the output written to the file
+  // descriptor, if any.
+  pid_t					m_compression_pid;
   bool					m_annotate;
   bool					m_show_locs;
   bool					m_write_architecture;
@@ -246,6 +434,8 @@ public:
     : m_env(env),
       m_id_manager(env),
       m_ostream(&os),
+      m_ostream_before_fd(),
+      m_compression_pid(),
       m_annotate(false),
       m_show_locs(true),
       m_write_architecture(true),
@@ -258,6 +448,9 @@ public:
       m_type_id_style(SEQUENCE_TYPE_ID_STYLE)
   {}
 
+  ~write_context()
+  {close_output_fd();}
+
   /// Getter of the environment we are operating from.
   ///
   /// @return the environment we are operating from.
@@ -281,7 +474,67 @@ public:
   /// @param os the new ostream
   void
   set_ostream(ostream& os)
-  {m_ostream = &os;}
+  {
+    close_output_fd();
+    m_ostream = &os;
+  }
+
+  /// Make the output be written to a file descriptor, through a
+  /// large buffer.
+  ///
+  /// @param fd the file descriptor to write to.
+  ///
+  /// @param owns_fd if true, then @p fd is closed by
+  /// close_output_fd().
+  ///
+  /// @param compression_pid if non-zero, the id of the process that
+  /// compresses what is written to @p fd.  close_output_fd() waits
+  /// for it.
+  void
+  set_output_fd(int fd, bool owns_fd, pid_t compression_pid = 0)
+  {
+    close_output_fd();
+    m_compression_pid = compression_pid;
+    m_fd_streambuf.reset(new fd_streambuf(fd, owns_fd));
+    m_fd_ostream.reset(new ostream(m_fd_streambuf.get()));
+    m_ostream_before_fd = m_ostream;
+    m_ostream = m_fd_ostream.get();
+  }
+
+  /// Flush the output written to the file descriptor set by
+  /// set_output_fd() and close it if it's owned by this context.
+  ///
+  /// The output then goes back to the ostream that was used before
+  /// set_output_fd() was called.
+  ///
+  /// @return true iff all the output could be written out.
+  bool
+  close_output_fd()
+  {
+    if (!m_fd_streambuf)
+      return true;
+
+    bool ok = m_fd_streambuf->close() && m_fd_ostream->good();
+    if (m_compression_pid)
+      {
+	if (!tools_utils::wait_for_compression_process(m_compression_pid))
+	  ok = false;
+	m_compression_pid = 0;
+      }
+    if (m_ostream == m_fd_ostream.get())
+      m_ostream = m_ostream_before_fd;
+    m_fd_ostream.reset();
+    m_fd_streambuf.reset();
+    return ok;
+  }
+
+  /// Getter of the number of bytes written to the file descriptor
+  /// set by set_output_fd().
+  ///
+  /// @return the number of bytes written so far.
+  unsigned long long
+  get_nb_bytes_written_to_fd() const
+  {return m_fd_streambuf ? m_fd_streambuf->get_nb_bytes_written() : 0;}
 
   /// Getter of the annotation option.
   ///
@@ -492,9 +745,11 @@ public:
 	  size_t hash = hashing::fnv_hash(pretty);
 	  while (!m_used_type_id_hashes.insert(hash).second)
 	    ++hash;
-	  std::ostringstream os;
-	  os << std::hex << std::setfill('0') << std::setw(8) << hash;
-	  return m_type_id_map[c] = c->get_environment().intern(os.str());
+	  // Format the hash as a zero-padded hexadecimal number of at
+	  // least 8 digits.
+	  char buf[2 * sizeof(size_t) + 1];
+	  snprintf(buf, sizeof(buf), "%08zx", hash);
+	  return m_type_id_map[c] = c->get_environment().intern(buf);
 	}
       }
     ABG_ASSERT_NOT_REACHED;
@@ -533,6 +788,14 @@ public:
     m_type_id_map.clear();
   }
 
+  /// Getter of the map that associates the types emitted so far to
+  /// their type id.
+  ///
+  /// @return the map of types and their type ids.
+  const type_ptr_map&
+  get_type_id_map() const
+  {return m_type_id_map;}
+
 
   /// Getter of the set of types that were referenced by a pointer,
   /// reference or typedef.
@@ -688,6 +951,56 @@ public:
     {return operator()(l.get(), r.get());}
   }; // end struct type_ptr_cmp
 
+  /// Sort a vector of types the way @ref type_ptr_cmp does, but
+  /// computing the pretty representation of each type only once.
+  ///
+  /// type_ptr_cmp builds the pretty representations of its two
+  /// operands at each comparison, which makes sorting n types build
+  /// O(n log n) such strings.  Here, they are built upfront and used
+  /// as the primary sort key; type_ptr_cmp is only invoked to break
+  /// ties between types that have the same pretty representation.
+  /// The resulting order is thus the same as the one of sorting with
+  /// type_ptr_cmp.
+  ///
+  /// @param types the vector of types to sort in place.
+  template<typename type_ptr>
+  void
+  sort_types_by_representation(vector<type_ptr>& types)
+  {
+    struct keyed_type
+    {
+      string repr;
+      type_ptr type;
+    };
+
+    vector<keyed_type> keyed;
+    keyed.reserve(types.size());
+    for (auto& t : types)
+      {
+	keyed_type k;
+	if (t)
+	  k.repr = ir::get_pretty_representation(&*t, true);
+	k.type = std::move(t);
+	keyed.push_back(std::move(k));
+      }
+
+    type_ptr_cmp comp(&m_type_id_map);
+    std::sort(keyed.begin(), keyed.end(),
+	      [&comp](const keyed_type& l, const keyed_type& r)
+	      {
+		if (!l.type || !r.type)
+		  return comp(l.type, r.type);
+		int c = l.repr.compare(r.repr);
+		if (c)
+		  return c < 0;
+		return comp(l.type, r.type);
+	      });
+
+    types.clear();
+    for (auto& k : keyed)
+      types.push_back(std::move(k.type));
+  }
+
   /// Sort the content of a map of type pointers into a vector.
   ///
   /// The pointers are sorted by using their string representation as
@@ -701,13 +1014,11 @@ public:
   sort_types(type_ptr_set_type& types,
 	     vector<type_base*>& sorted)
   {
-    string id;
     for (type_ptr_set_type::const_iterator i = types.begin();
 	 i != types.end();
 	 ++i)
       sorted.push_back(const_cast<type_base*>(*i));
-    type_ptr_cmp comp(&m_type_id_map);
-    sort(sorted.begin(), sorted.end(), comp);
+    sort_types_by_representation(sorted);
   }
 
   /// Sort the content of a map of type pointers into a vector.
@@ -727,8 +1038,7 @@ public:
 	 i != types.end();
 	 ++i)
       sorted.push_back(type_base_sptr(i->second));
-    type_ptr_cmp comp(&m_type_id_map);
-    sort(sorted.begin(), sorted.end(), comp);
+    sort_types_by_representation(sorted);
   }
 
   /// Sort the content of a vector of function types into a vector of
@@ -749,8 +1059,7 @@ public:
 	 i != types.end();
 	 ++i)
       sorted.push_back(*i);
-    type_ptr_cmp comp(&m_type_id_map);
-    sort(sorted.begin(), sorted.end(), comp);
+    sort_types_by_representation(sorted);
   }
 
   /// Flag a type as having been written out to the XML output.
@@ -977,8 +1286,14 @@ static unsigned get_indent_to_level(write_context&, unsigned, unsigned);
 void
 do_indent(ostream& o, unsigned nb_whitespaces)
 {
-  for (unsigned i = 0; i < nb_whitespaces; ++i)
-    o << ' ';
+  static const char spaces[] = "                                ";
+  const unsigned nb_spaces = sizeof(spaces) - 1;
+  while (nb_whitespaces > nb_spaces)
+    {
+      o.write(spaces, nb_spaces);
+      nb_whitespaces -= nb_spaces;
+    }
+  o.write(spaces, nb_whitespaces);
 }
 
 /// Indent initial_indent + level number of xml element indentation.
@@ -2145,6 +2460,85 @@ void
 set_ostream(write_context& ctxt, ostream& os)
 {ctxt.set_ostream(os);}
 
+/// Make the XML writer emit its output to a given file.
+///
+/// The output is then accumulated into a large buffer that is
+/// written to the file descriptor of the file as it fills up.  This
+/// is noticeably faster than going through an std::ofstream for big
+/// outputs.  The file must be closed with close_output_file for the
+/// output to be completely written out.
+///
+/// If the name of the file ends with ".gz", ".xz" or ".zst", then
+/// the output is compressed on the fly with the matching scheme.
+///
+/// @param ctxt the context to set the output for.
+///
+/// @param path the path to the file to write to.  The file is
+/// created if it doesn't exist, and truncated otherwise.
+///
+/// @return true iff the file could be opened.
+bool
+set_output_file(write_context& ctxt, const string& path)
+{
+  tools_utils::compression_kind compression =
+    tools_utils::get_compression_kind_from_file_name(path);
+  if (compression != tools_utils::COMPRESSION_NONE)
+    {
+      pid_t pid = 0;
+      int fd = tools_utils::open_compressed_output_file(path, compression,
+							pid);
+      if (fd < 0)
+	return false;
+      ctxt.set_output_fd(fd, /*owns_fd=*/true, pid);
+      return true;
+    }
+
+  int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (fd < 0)
+    return false;
+  ctxt.set_output_fd(fd, /*owns_fd=*/true);
+  return true;
+}
+
+/// Flush and close the file set by set_output_file.
+///
+/// @param ctxt the context to consider.
+///
+/// @return true iff all the output could be written to the file.
+bool
+close_output_file(write_context& ctxt)
+{return ctxt.close_output_fd();}
+
+/// Getter of the number of bytes written to the file set by
+/// set_output_file.
+///
+/// @param ctxt the context to consider.
+///
+/// @return the number of bytes written so far.
+unsigned long long
+get_nb_bytes_written_to_output_file(const write_context& ctxt)
+{return ctxt.get_nb_bytes_written_to_fd();}
+
+/// Get the canonical types that were emitted, along with their type
+/// ids.
+///
+/// This is meant to be used with
+/// abixml::set_canonical_type_hints, when reading back the emitted
+/// abixml into the same environment.
+///
+/// @param ctxt the context used to emit the abixml.
+///
+/// @param types output parameter.  The type ids of the emitted
+/// canonical types and the canonical types are added to this map.
+void
+get_canonical_types_of_type_ids(const write_context& ctxt,
+				unordered_map<string, type_base*>& types)
+{
+  for (const auto& i : ctxt.get_type_id_map())
+    if (i.first->get_naked_canonical_type() == i.first)
+      types[i.second] = i.first;
+}
+
 /// Set the 'write-architecture' flag.
 ///
 /// When this flag is set then the XML writer will emit architecture
@@ -0,0 +1,37 @@
+/* A fake Linux kernel module exporting a function and a variable
+   through its ksymtab, with CRCs and a symbol namespace.
+
+   Compile with:
+     gcc -c -O2 -fno-asynchronous-unwind-tables -o test0-kmod-v0.o test0-kmod-v0.c
+*/
+
+int exported_var = 1;
+
+int
+exported_fn(void)
+{
+  return exported_var;
+}
+
+asm(".pushsection .modinfo,\"a\"\n"
+    ".string \"license=GPL\"\n"
+    ".popsection\n"
+    ".pushsection .gnu.linkonce.this_module,\"aw\"\n"
+    ".zero 16\n"
+    ".popsection\n"
+    ".pushsection __ksymtab_strings,\"a\"\n"
+    "__kstrtab_exported_fn: .string \"exported_fn\"\n"
+    "__kstrtabns_exported_fn: .string \"NS_A\"\n"
+    "__kstrtab_exported_var: .string \"exported_var\"\n"
+    "__kstrtabns_exported_var: .string \"\"\n"
+    ".popsection\n"
+    ".pushsection ___ksymtab+exported_fn,\"a\"\n"
+    "__ksymtab_exported_fn: .quad exported_fn\n"
+    ".popsection\n"
+    ".pushsection ___ksymtab+exported_var,\"a\"\n"
+    "__ksymtab_exported_var: .quad exported_var\n"
+    ".popsection\n"
+    ".globl __crc_exported_fn\n"
+    ".set __crc_exported_fn, 0x11111111\n"
+    ".globl __crc_exported_var\n"
+    ".set __crc_exported_var, 0x22222222\n");
@@ -0,0 +1,12 @@
+/* Compile with:
+     gcc -shared -fPIC -Wl,--version-script=test1-versions-v0.map \
+       -o libtest1-versions-v0.so test1-versions-v0.c
+*/
+
+int bar = 0;
+
+int
+foo(void)
+{
+  return bar;
+}
@@ -0,0 +1,12 @@
+/* Compile with:
+     gcc -shared -fPIC -Wl,--version-script=test1-versions-v1.map \
+       -o libtest1-versions-v1.so test1-versions-v1.c
+*/
+
+int bar = 0;
+
+int
+foo(void)
+{
+  return bar;
+}
@@ -0,0 +1,38 @@
+/* A minimal stand-in for a Linux Kernel module that exports mod_fn
+   through its ksymtab.  Its .BTF section is split BTF on top of the
+   one of the vmlinux binary of this directory.  It describes the
+   types below, where 'base_struct' is the type 2 of vmlinux:
+
+   [6] STRUCT 'mod_struct' size=8
+	'b' type=3 offset=0
+   [7] PTR type=6
+   [8] FUNC_PROTO return=1
+	'm' type=7
+   [9] FUNC 'mod_fn' type=8 linkage=global
+
+   It was compiled with:
+     gcc -c -o module.ko module.c
+   and the .BTF section was then added with objcopy.  */
+
+struct base_struct;
+
+struct mod_struct
+{
+  struct base_struct *b;
+};
+
+int
+mod_fn(struct mod_struct *m)
+{return m->b != 0;}
+
+__attribute__((section(".modinfo")))
+const char __modinfo_license[] = "license=GPL";
+
+__attribute__((section(".gnu.linkonce.this_module")))
+char __this_module[64] = {1};
+
+__attribute__((section("__ksymtab_strings")))
+const char __kstrtab_mod_fn[] = "mod_fn";
+
+__attribute__((section("___ksymtab+mod_fn")))
+const void* const __ksymtab_mod_fn = mod_fn;
@@ -0,0 +1,29 @@
+/* A minimal stand-in for a vmlinux binary that exports base_fn
+   through its ksymtab.  Its .BTF section describes the types below:
+
+   [1] INT 'int' size=4 bits=32 signed
+   [2] STRUCT 'base_struct' size=4
+	'a' type=1 offset=0
+   [3] PTR type=2
+   [4] FUNC_PROTO return=1
+	'p' type=3
+   [5] FUNC 'base_fn' type=4 linkage=global
+
+   It was compiled with:
+     gcc -c -o vmlinux vmlinux.c
+   and the .BTF section was then added with objcopy.  */
+
+struct base_struct
+{
+  int a;
+};
+
+int
+base_fn(struct base_struct *p)
+{return p->a;}
+
+__attribute__((section("__ksymtab_strings")))
+const char __kstrtab_base_fn[] = "base_fn";
+
+__attribute__((section("___ksymtab+base_fn")))
+const void* const __ksymtab_base_fn = base_fn;
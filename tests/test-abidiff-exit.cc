@@ -861,6 +861,47 @@ InOutSpec in_out_specs[] =
     "data/test-abidiff-exit/PR30329/PR30329-report-1.txt",
     "output/test-abidiff-exit/PR30329/PR30329-report-1.txt"
   },
+  {
+    "data/test-abidiff-exit/symbols-only/test0-kmod-v0.o",
+    "data/test-abidiff-exit/symbols-only/test0-kmod-v0.o",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "--no-default-suppression --symbols-only",
+    abigail::tools_utils::ABIDIFF_OK,
+    "data/test-abidiff-exit/symbols-only/test0-kmod-report-same.txt",
+    "output/test-abidiff-exit/symbols-only/test0-kmod-report-same.txt"
+  },
+  {
+    "data/test-abidiff-exit/symbols-only/test0-kmod-v0.o",
+    "data/test-abidiff-exit/symbols-only/test0-kmod-v1.o",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "--no-default-suppression --symbols-only",
+    abigail::tools_utils::ABIDIFF_ABI_CHANGE
+    | abigail::tools_utils::ABIDIFF_ABI_INCOMPATIBLE_CHANGE,
+    "data/test-abidiff-exit/symbols-only/test0-kmod-report.txt",
+    "output/test-abidiff-exit/symbols-only/test0-kmod-report.txt"
+  },
+  {
+    "data/test-abidiff-exit/symbols-only/libtest1-versions-v0.so",
+    "data/test-abidiff-exit/symbols-only/libtest1-versions-v1.so",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "--no-default-suppression --symbols-only",
+    abigail::tools_utils::ABIDIFF_ABI_CHANGE
+    | abigail::tools_utils::ABIDIFF_ABI_INCOMPATIBLE_CHANGE,
+    "data/test-abidiff-exit/symbols-only/test1-versions-report.txt",
+    "output/test-abidiff-exit/symbols-only/test1-versions-report.txt"
+  },
 #ifdef WITH_BTF
   {
     "data/test-abidiff-exit/btf/test0-v0.o",
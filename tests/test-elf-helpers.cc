@@ -13,3 +13,185 @@
 
 #include "abg-elf-helpers.h"
 
+#include "abg-tools-utils.h"
+#include "test-utils.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+using abigail::elf_helpers::debug_info_root_index;
+using abigail::elf_helpers::debug_info_root_index_sptr;
+using abigail::elf_helpers::get_debug_info_root_index;
+
+/// The directory where the test debug info root directories are
+/// created.
+static const std::string output_dir =
+  std::string(abigail::tests::get_build_dir())
+  + "/tests/output/test-elf-helpers/";
+
+/// Create an empty file, along with its parent directories.
+///
+/// @param path the path of the file to create.
+static void
+create_file(const std::string& path)
+{
+  REQUIRE(abigail::tools_utils::ensure_parent_dir_created(path));
+  std::ofstream o(path.c_str());
+  REQUIRE(o.good());
+}
+
+/// Create a debug info root directory that looks like
+///
+///   usr/lib/debug/libfoo.so.debug
+///   .build-id/ab/cdef0123.debug
+///   .build-id/12/3456 -> ../../usr/lib/debug/libfoo.so.debug
+///
+/// @param name the name of the directory to create under the output
+/// directory of the test.  If the directory already exists, it's
+/// removed first.
+///
+/// @return the path to the root directory, without a trailing '/'.
+static std::string
+create_debug_info_root(const std::string& name)
+{
+  std::string root = output_dir + name;
+  REQUIRE(system(("rm -rf " + root).c_str()) == 0);
+
+  create_file(root + "/usr/lib/debug/libfoo.so.debug");
+  create_file(root + "/.build-id/ab/cdef0123.debug");
+  REQUIRE(abigail::tools_utils::ensure_dir_path_created(root
+							 + "/.build-id/12"));
+  REQUIRE(symlink("../../usr/lib/debug/libfoo.so.debug",
+		  (root + "/.build-id/12/3456").c_str()) == 0);
+  return root;
+}
+
+/// Set the time of last modification of a directory to a time that
+/// it can't already have, as if an entry was added to it.
+///
+/// @param dir the directory to consider.
+static void
+touch_dir(const std::string& dir)
+{
+  struct timespec times[2] = {{1, 0}, {1, 0}};
+  REQUIRE(utimensat(AT_FDCWD, dir.c_str(), times, 0) == 0);
+}
+
+/// Check the lookups in the index of a root directory created by
+/// create_debug_info_root().
+///
+/// @param index the index to check.
+///
+/// @param root the root directory of @p index, without a trailing
+/// '/'.
+static void
+check_lookups(const debug_info_root_index& index, const std::string& root)
+{
+  std::string path;
+
+  CHECK(index.size() == 3);
+  CHECK(index.root_dir() == root + "/");
+
+  // By relative path.
+  REQUIRE(index.find_file("usr/lib/debug/libfoo.so.debug", path));
+  CHECK(path == root + "/usr/lib/debug/libfoo.so.debug");
+
+  // By file name.
+  path.clear();
+  REQUIRE(index.find_file("libfoo.so.debug", path));
+  CHECK(path == root + "/usr/lib/debug/libfoo.so.debug");
+
+  CHECK_FALSE(index.find_file("libbar.so.debug", path));
+
+  // By build ID.
+  REQUIRE(index.find_file_by_build_id("abcdef0123", ".debug", path));
+  CHECK(path == root + "/.build-id/ab/cdef0123.debug");
+  CHECK_FALSE(index.find_file_by_build_id("abcdef0123", "", path));
+
+  // Symbolic links can only be looked up by build ID.
+  CHECK_FALSE(index.find_file("3456", path));
+  REQUIRE(index.find_file_by_build_id("123456", "", path));
+  CHECK(path == root + "/.build-id/12/3456");
+}
+
+TEST_CASE("DebugInfoRootIndex::Build", "[elf_helpers, debug_info_index]")
+{
+  const std::string root = create_debug_info_root("build");
+
+  debug_info_root_index index(root);
+  CHECK(index.size() == 0);
+  index.build();
+  check_lookups(index, root);
+  CHECK(index.is_up_to_date());
+
+  touch_dir(root + "/usr/lib/debug");
+  CHECK_FALSE(index.is_up_to_date());
+
+  index.build();
+  CHECK(index.is_up_to_date());
+}
+
+TEST_CASE("DebugInfoRootIndex::SaveLoad", "[elf_helpers, debug_info_index]")
+{
+  const std::string root = create_debug_info_root("save-load");
+  const std::string cache_path = output_dir + "save-load.index";
+
+  debug_info_root_index index(root);
+  index.build();
+  REQUIRE(index.save(cache_path));
+
+  debug_info_root_index loaded(root);
+  REQUIRE(loaded.load(cache_path));
+  check_lookups(loaded, root);
+
+  // The cache file of another root directory is not loaded.
+  debug_info_root_index other(root + "/usr");
+  CHECK_FALSE(other.load(cache_path));
+  CHECK(other.size() == 0);
+
+  // An out of date cache file is not loaded.
+  touch_dir(root + "/.build-id/ab");
+  debug_info_root_index out_of_date(root);
+  CHECK_FALSE(out_of_date.load(cache_path));
+  CHECK(out_of_date.size() == 0);
+}
+
+TEST_CASE("DebugInfoRootIndex::MissingRoot", "[elf_helpers, debug_info_index]")
+{
+  const std::string root = output_dir + "missing-root";
+  REQUIRE(system(("rm -rf " + root).c_str()) == 0);
+
+  debug_info_root_index index(root);
+  index.build();
+  CHECK(index.size() == 0);
+  // An empty index stays valid for as long as its root is missing.
+  CHECK(index.is_up_to_date());
+
+  create_file(root + "/libfoo.so.debug");
+  CHECK_FALSE(index.is_up_to_date());
+}
+
+TEST_CASE("DebugInfoRootIndex::Shared", "[elf_helpers, debug_info_index]")
+{
+  const std::string root = create_debug_info_root("shared");
+
+  debug_info_root_index_sptr index = get_debug_info_root_index(root);
+  REQUIRE(index);
+  check_lookups(*index, root);
+  CHECK(get_debug_info_root_index(root) == index);
+  CHECK(get_debug_info_root_index(root, /*revalidate=*/true) == index);
+
+  // The index is only checked against the directory tree when
+  // revalidating it.
+  touch_dir(root + "/usr/lib");
+  CHECK(get_debug_info_root_index(root) == index);
+  debug_info_root_index_sptr rebuilt =
+    get_debug_info_root_index(root, /*revalidate=*/true);
+  CHECK(rebuilt != index);
+  check_lookups(*rebuilt, root);
+  CHECK(get_debug_info_root_index(root) == rebuilt);
+}
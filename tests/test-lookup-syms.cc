@@ -81,6 +81,20 @@ InOutSpec in_out_specs[] =
     "data/test-lookup-syms/test1-3-report.txt",
     "output/test-lookup-syms/test-3-report.txt"
   },
+  {
+    "data/test-lookup-syms/test0.o",
+    "main foo",
+    "",
+    "data/test-lookup-syms/test0-multi-report.txt",
+    "output/test-lookup-syms/test0-multi-report.txt"
+  },
+  {
+    "data/test-lookup-syms/test1.so",
+    "foo _foo1",
+    "--no-absolute-path",
+    "data/test-lookup-syms/test1-multi-report.txt",
+    "output/test-lookup-syms/test1-multi-report.txt"
+  },
   // This should always be the last entry.
   {NULL, NULL, NULL, NULL, NULL}
 };
@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// -*- Mode: C++ -*-
+//
+// Copyright (C) 2023 Red Hat, Inc.
+
+/// @file
+///
+/// This program runs abidw and abidiff with the --stats option on
+/// some big binaries of the test suite and checks that the
+/// approximate memory they report using stays within a given budget.
+///
+/// The budget of each input is about 2 to 3 times the memory the tool
+/// reports for it, so that small variations of the memory footprint
+/// don't make the test fail, but a regression that makes it grow
+/// noticeably does.  The budgets must be updated when the memory
+/// footprint of the tools changes on purpose.
+
+#include <sys/wait.h>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "abg-tools-utils.h"
+#include "test-utils.h"
+
+using std::string;
+using std::ifstream;
+using std::cerr;
+using abigail::tests::emit_test_status_and_update_counters;
+using abigail::tests::emit_test_summary;
+
+/// This is an aggregate that specifies a run of a tool whose memory
+/// usage is to be checked.
+struct InOutSpec
+{
+  /// The name of the tool to run.
+  const char*	tool;
+  /// The options to pass to the tool, in addition to --stats.
+  const char*	options;
+  /// The first input file.
+  const char*	in_path1;
+  /// The second input file, for abidiff.  Empty for abidw.
+  const char*	in_path2;
+  /// The maximum approximate memory the tool can report, in MB.
+  unsigned	max_memory_in_mb;
+  /// Where to write the statistics emitted by the tool.
+  const char*	out_path;
+};// end struct InOutSpec
+
+InOutSpec in_out_specs[] =
+{
+  {
+    "abidw",
+    "--noout",
+    "data/test-read-dwarf/test12-pr18844.so",
+    "",
+    64,
+    "output/test-memory-usage/test12-pr18844.so.stats.txt"
+  },
+  {
+    "abidw",
+    "--noout",
+    "data/test-read-dwarf/test14-pr18893.so",
+    "",
+    10,
+    "output/test-memory-usage/test14-pr18893.so.stats.txt"
+  },
+  {
+    "abidw",
+    "--noout",
+    "data/test-read-dwarf/test-libandroid.so",
+    "",
+    96,
+    "output/test-memory-usage/test-libandroid.so.stats.txt"
+  },
+  {
+    "abidiff",
+    "--no-default-suppression",
+    "data/test-abidiff/test-PR18791-v0.so.abi",
+    "data/test-abidiff/test-PR18791-v1.so.abi",
+    5,
+    "output/test-memory-usage/test-PR18791.stats.txt"
+  },
+  // This should be the last entry.
+  {0, 0, 0, 0, 0, 0}
+};
+
+/// Read the approximate memory used by a tool from the statistics it
+/// emitted.
+///
+/// @param path the path to the file containing the statistics.
+///
+/// @param memory_in_mb output parameter.  This is set to the
+/// approximate memory used, in MB, iff the function returns true.
+///
+/// @return true iff the approximate memory used was found in @p path.
+static bool
+read_memory_usage(const string& path, unsigned long& memory_in_mb)
+{
+  const string prefix = "approximate memory used: ";
+  ifstream in(path.c_str());
+  string line;
+  while (std::getline(in, line))
+    {
+      string::size_type pos = line.find(prefix);
+      if (pos == string::npos)
+	continue;
+      memory_in_mb = strtoul(line.c_str() + pos + prefix.size(), 0, 10);
+      return true;
+    }
+  return false;
+}
+
+int
+main()
+{
+  using abigail::tests::get_src_dir;
+  using abigail::tests::get_build_dir;
+  using abigail::tools_utils::ensure_parent_dir_created;
+
+  unsigned total_count = 0, passed_count = 0, failed_count = 0;
+
+  string source_dir_prefix = string(get_src_dir()) + "/tests/";
+  string build_dir_prefix = string(get_build_dir()) + "/tests/";
+
+  for (InOutSpec* s = in_out_specs; s->tool; ++s)
+    {
+      string out_path = build_dir_prefix + s->out_path;
+      if (!ensure_parent_dir_created(out_path))
+	{
+	  cerr << "could not create parent directory for "
+	       << out_path << "\n";
+	  ++failed_count;
+	  ++total_count;
+	  continue;
+	}
+
+      string cmd = string(get_build_dir()) + "/tools/" + s->tool
+	+ " --stats " + s->options
+	+ " " + source_dir_prefix + s->in_path1;
+      if (s->in_path2[0])
+	cmd += " " + source_dir_prefix + s->in_path2;
+      cmd += " > /dev/null 2> " + out_path;
+
+      bool is_ok = true;
+      int code = system(cmd.c_str());
+      if (!WIFEXITED(code)
+	  || (WEXITSTATUS(code) & abigail::tools_utils::ABIDIFF_ERROR))
+	{
+	  cerr << "command '" << cmd << "' failed\n";
+	  is_ok = false;
+	}
+
+      unsigned long memory_in_mb = 0;
+      if (is_ok)
+	{
+	  if (!read_memory_usage(out_path, memory_in_mb))
+	    {
+	      cerr << "no memory usage found in " << out_path << "\n";
+	      is_ok = false;
+	    }
+	  else if (memory_in_mb > s->max_memory_in_mb)
+	    {
+	      cerr << "for command '" << cmd << "', the approximate memory "
+		   << "used is " << memory_in_mb << " MB, which exceeds "
+		   << "the budget of " << s->max_memory_in_mb << " MB\n";
+	      is_ok = false;
+	    }
+	}
+
+      emit_test_status_and_update_counters(is_ok, cmd, passed_count,
+					   failed_count, total_count);
+    }
+
+  emit_test_summary(total_count, passed_count, failed_count);
+
+  return failed_count;
+}
@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// -*- Mode: C++ -*-
+//
+// Copyright (C) 2023 Red Hat, Inc.
+
+/// @file
+///
+/// This program reads an abixml corpus that has enough abi-instr
+/// elements for the ids of its types to be collected by worker
+/// threads.  It checks that the corpus read that way is the same as
+/// the one read without worker threads.
+///
+/// The corpus is generated by the program.  The function declared in
+/// each abi-instr element has a parameter whose type is defined in
+/// the next abi-instr element, so the corpus can only be read if the
+/// ids of the types of all the abi-instr elements have been
+/// collected.
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "abg-ir.h"
+#include "abg-reader.h"
+#include "abg-writer.h"
+#include "test-utils.h"
+
+using std::string;
+using std::ostringstream;
+using std::istringstream;
+using std::cerr;
+using abigail::ir::environment;
+using abigail::corpus_sptr;
+using abigail::fe_iface;
+using abigail::fe_iface_sptr;
+using abigail::tests::emit_test_status_and_update_counters;
+using abigail::tests::emit_test_summary;
+
+/// The number of abi-instr elements of the generated corpus.
+///
+/// The ids of the types are collected by worker threads only if
+/// there are at least 64 abi-instr elements per thread.
+static const unsigned nb_translation_units = 512;
+
+/// Generate the abixml corpus to read.
+///
+/// @return the abixml corpus.
+static string
+generate_corpus()
+{
+  ostringstream o;
+  o << "<abi-corpus version='2.2' path='many-translation-units.so'>\n"
+    << "  <elf-function-symbols>\n";
+  for (unsigned i = 0; i < nb_translation_units; ++i)
+    o << "    <elf-symbol name='f" << i << "' type='func-type'"
+      << " binding='global-binding' visibility='default-visibility'"
+      << " is-defined='yes'/>\n";
+  o << "  </elf-function-symbols>\n";
+
+  for (unsigned i = 0; i < nb_translation_units; ++i)
+    {
+      o << "  <abi-instr address-size='64' path='tu" << i
+	<< ".c' language='LANG_C99'>\n";
+      if (i == 0)
+	o << "    <type-decl name='int' size-in-bits='32'"
+	  << " id='type-id-0'/>\n";
+      o << "    <typedef-decl name='t" << i << "' type-id='type-id-0'"
+	<< " id='type-id-" << i + 1 << "'/>\n"
+	<< "    <function-decl name='f" << i << "' mangled-name='f" << i
+	<< "' visibility='default' binding='global' size-in-bits='64'"
+	<< " elf-symbol-id='f" << i << "'>\n";
+      if (i + 1 < nb_translation_units)
+	o << "      <parameter type-id='type-id-" << i + 2 << "'/>\n";
+      o << "      <return type-id='type-id-" << i + 1 << "'/>\n"
+	<< "    </function-decl>\n"
+	<< "  </abi-instr>\n";
+    }
+  o << "</abi-corpus>\n";
+  return o.str();
+}
+
+/// Read an abixml corpus and emit it back.
+///
+/// @param corpus the abixml corpus to read.
+///
+/// @param nb_worker_threads the number of worker threads the reader
+/// can use.
+///
+/// @param out the output stream to emit the corpus to.
+///
+/// @return true iff the corpus could be read.
+static bool
+read_and_emit(const string& corpus,
+	      size_t nb_worker_threads,
+	      std::ostream& out)
+{
+  environment env;
+  istringstream in(corpus);
+  fe_iface_sptr rdr = abigail::abixml::create_reader(&in, env);
+  if (!rdr)
+    return false;
+  rdr->options().nb_worker_threads = nb_worker_threads;
+
+  fe_iface::status status = fe_iface::STATUS_UNKNOWN;
+  corpus_sptr corp = rdr->read_corpus(status);
+  if (!corp || corp->get_translation_units().size() != nb_translation_units)
+    {
+      cerr << "could not read the corpus with " << nb_worker_threads
+	   << " worker threads\n";
+      return false;
+    }
+
+  abigail::xml_writer::write_context_sptr ctxt =
+    abigail::xml_writer::create_write_context(env, out);
+  return abigail::xml_writer::write_corpus(*ctxt, corp, /*indent=*/0);
+}
+
+int
+main()
+{
+  unsigned total_count = 0, passed_count = 0, failed_count = 0;
+
+  string corpus = generate_corpus();
+
+  ostringstream ref_out;
+  bool ref_is_ok = read_and_emit(corpus, 1, ref_out);
+  if (ref_is_ok && ref_out.str().find("name='t0'") == string::npos)
+    {
+      cerr << "the declarations of the corpus were not read\n";
+      ref_is_ok = false;
+    }
+  emit_test_status_and_update_counters(ref_is_ok,
+				       "read without worker threads",
+				       passed_count, failed_count,
+				       total_count);
+
+  for (size_t nb_threads : {2, 4, 8})
+    {
+      ostringstream out;
+      bool is_ok = ref_is_ok && read_and_emit(corpus, nb_threads, out);
+      if (is_ok && out.str() != ref_out.str())
+	{
+	  cerr << "the corpus read with " << nb_threads
+	       << " worker threads differs from the one read without "
+	       << "worker threads\n";
+	  is_ok = false;
+	}
+
+      ostringstream cmd;
+      cmd << "read with " << nb_threads << " worker threads";
+      emit_test_status_and_update_counters(is_ok, cmd.str(), passed_count,
+					   failed_count, total_count);
+    }
+
+  emit_test_summary(total_count, passed_count, failed_count);
+
+  return failed_count;
+}
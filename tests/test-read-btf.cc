@@ -168,6 +168,88 @@ new_task(const InOutSpec* s, string& a_out_abi_base,
                            a_in_elf_base, a_in_abi_base);
 }
 
+/// Test that the BTF of a Linux Kernel module is read as split BTF
+/// on top of the BTF of the vmlinux binary read before it, by the
+/// same reader.
+///
+/// The module refers to a type of vmlinux.  The IR node of that type
+/// must be the one that was built when reading vmlinux.
+///
+/// @return true iff the test passed.
+static bool
+test_split_btf()
+{
+#ifdef WITH_BTF__PARSE_SPLIT
+  string dir = string(abigail::tests::get_src_dir())
+    + "/tests/data/test-read-btf/split/";
+  string vmlinux_path = dir + "vmlinux";
+  string module_path = dir + "module.ko";
+
+  abigail::ir::environment env;
+  vector<char**> di_roots;
+  abigail::fe_iface::status status = abigail::fe_iface::STATUS_UNKNOWN;
+  abigail::elf_based_reader_sptr rdr =
+    create_reader(vmlinux_path, di_roots, env,
+		  /*load_all_types=*/false,
+		  /*linux_kernel_mode=*/true);
+  ABG_ASSERT(rdr);
+
+  corpus_sptr vmlinux = rdr->read_corpus(status);
+  const std::unordered_set<abigail::ir::function_decl*>* fns =
+    vmlinux ? vmlinux->lookup_functions("base_fn") : nullptr;
+  if (!fns || fns->empty())
+    {
+      cerr << "failed to read function base_fn from "
+	   << vmlinux_path << "\n";
+      return false;
+    }
+  // The type of the parameter of base_fn is 'struct base_struct*'.
+  abigail::ir::type_base_sptr base_struct =
+    abigail::ir::is_pointer_type
+    ((*fns->begin())->get_parameters()[0]->get_type())->get_pointed_to_type();
+
+  rdr->initialize(module_path, di_roots,
+		  /*load_all_types=*/false,
+		  /*linux_kernel_mode=*/true);
+  corpus_sptr module = rdr->read_corpus(status);
+  fns = module ? module->lookup_functions("mod_fn") : nullptr;
+  if (!fns || fns->empty())
+    {
+      cerr << "failed to read function mod_fn from "
+	   << module_path << "\n";
+      return false;
+    }
+
+  // The type of the parameter of mod_fn is 'struct mod_struct*' and
+  // the type of the only data member of 'struct mod_struct' is
+  // 'struct base_struct*'.
+  abigail::ir::class_decl_sptr mod_struct =
+    abigail::ir::is_class_type
+    (abigail::ir::is_pointer_type
+     ((*fns->begin())->get_parameters()[0]->get_type())
+     ->get_pointed_to_type());
+  if (!mod_struct
+      || mod_struct->get_name() != "mod_struct"
+      || mod_struct->get_data_members().size() != 1)
+    {
+      cerr << "wrong type for the parameter of mod_fn in "
+	   << module_path << "\n";
+      return false;
+    }
+
+  abigail::ir::type_base_sptr member_type =
+    abigail::ir::is_pointer_type
+    (mod_struct->get_data_members()[0]->get_type())->get_pointed_to_type();
+  if (member_type != base_struct)
+    {
+      cerr << "the type 'struct base_struct' of " << module_path
+	   << " was not resolved to the one of " << vmlinux_path << "\n";
+      return false;
+    }
+#endif
+  return true;
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -184,5 +266,10 @@ main(int argc, char *argv[])
   // compute number of tests to be executed.
   const size_t num_tests = sizeof(in_out_specs) / sizeof(InOutSpec) - 1;
 
-  return run_tests(num_tests, in_out_specs, opts, new_task);
+  // run_tests returns true iff a test failed.
+  bool failed = run_tests(num_tests, in_out_specs, opts, new_task);
+  if (!test_split_btf())
+    failed = true;
+
+  return failed;
 }
@@ -0,0 +1,236 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// -*- Mode: C++ -*-
+//
+// Copyright (C) 2023 Red Hat, Inc.
+
+/// @file
+///
+/// This program writes an ABI corpus into compressed abixml files,
+/// reads them back and checks that the corpus read back is emitted
+/// just like the initial one.  It also checks that a failure of the
+/// compression program is reported as an error of the writer.
+
+#include <sys/stat.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "abg-ir.h"
+#include "abg-reader.h"
+#include "abg-writer.h"
+#include "abg-tools-utils.h"
+#include "test-utils.h"
+
+using std::string;
+using std::ofstream;
+using std::cerr;
+using abigail::ir::environment;
+using abigail::corpus_sptr;
+using abigail::tools_utils::compression_kind;
+using abigail::tools_utils::file_type;
+using abigail::tests::emit_test_status_and_update_counters;
+using abigail::tests::emit_test_summary;
+
+/// The abixml file of the corpus to write compressed.  It's big
+/// enough to fill the pipe to the compression program.
+static const char* in_path =
+  "data/test-read-dwarf/test14-pr18893.so.abi";
+
+/// The directory of the output files of the tests.
+static const char* out_dir = "output/test-read-write-compressed";
+
+/// This is an aggregate that specifies a compression scheme to test.
+struct CompressionSpec
+{
+  const char*		program;
+  const char*		extension;
+  compression_kind	kind;
+};// end struct CompressionSpec
+
+CompressionSpec compression_specs[] =
+{
+  {"gzip", ".gz", abigail::tools_utils::COMPRESSION_GZIP},
+  {"xz", ".xz", abigail::tools_utils::COMPRESSION_XZ},
+  {"zstd", ".zst", abigail::tools_utils::COMPRESSION_ZSTD},
+  // This should be the last entry.
+  {0, 0, abigail::tools_utils::COMPRESSION_NONE}
+};
+
+/// Write a corpus into an abixml file.
+///
+/// @param corp the corpus to write.
+///
+/// @param path the path of the file to write.  If it ends with the
+/// extension of a compression scheme, the file is compressed.
+///
+/// @return true iff the corpus was written.
+static bool
+write_corpus_to_file(const corpus_sptr& corp, const string& path)
+{
+  using namespace abigail::xml_writer;
+
+  write_context_sptr ctxt = create_write_context(corp->get_environment(),
+						 cerr);
+  if (!set_output_file(*ctxt, path))
+    return false;
+  bool is_ok = write_corpus(*ctxt, corp, /*indent=*/0);
+  return close_output_file(*ctxt) && is_ok;
+}
+
+/// Read a corpus from a compressed abixml file and write it back
+/// uncompressed.
+///
+/// @param compressed_path the path of the compressed abixml file.
+///
+/// @param kind the compression scheme of @p compressed_path.
+///
+/// @param out_path the path of the uncompressed abixml file to write.
+///
+/// @return true iff the corpus could be read and written back.
+static bool
+read_compressed_corpus(const string& compressed_path,
+		       compression_kind kind,
+		       const string& out_path)
+{
+  if (abigail::tools_utils::guess_compression_kind(compressed_path) != kind)
+    {
+      cerr << compressed_path << " is not compressed as expected\n";
+      return false;
+    }
+
+  if (abigail::tools_utils::guess_file_type(compressed_path)
+      != abigail::tools_utils::FILE_TYPE_XML_CORPUS)
+    {
+      cerr << compressed_path << " is not recognized as an abixml corpus\n";
+      return false;
+    }
+
+  environment env;
+  corpus_sptr corp =
+    abigail::abixml::read_corpus_from_abixml_file(compressed_path, env);
+  if (!corp)
+    {
+      cerr << "could not read " << compressed_path << "\n";
+      return false;
+    }
+
+  return write_corpus_to_file(corp, out_path);
+}
+
+/// Create a fake compression program that exits right away, without
+/// reading its input.
+///
+/// @param dir the directory where to create the program.
+///
+/// @param program the name of the program.
+///
+/// @return true iff the program was created.
+static bool
+create_quitting_program(const string& dir, const string& program)
+{
+  string path = dir + "/" + program;
+  {
+    ofstream o(path.c_str());
+    o << "#!/bin/sh\nexit 0\n";
+    if (!o.good())
+      return false;
+  }
+  return chmod(path.c_str(), 0755) == 0;
+}
+
+int
+main()
+{
+  unsigned total_count = 0, passed_count = 0, failed_count = 0;
+
+  string src_path =
+    string(abigail::tests::get_src_dir()) + "/tests/" + in_path;
+  string out_prefix =
+    string(abigail::tests::get_build_dir()) + "/tests/" + out_dir + "/";
+  string ref_path = out_prefix + "ref.abi";
+
+  if (!abigail::tools_utils::ensure_dir_path_created(out_prefix))
+    {
+      cerr << "could not create " << out_prefix << "\n";
+      return 1;
+    }
+
+  environment env;
+  corpus_sptr corp =
+    abigail::abixml::read_corpus_from_abixml_file(src_path, env);
+  if (!corp || !write_corpus_to_file(corp, ref_path))
+    {
+      cerr << "could not read " << src_path
+	   << " and write it to " << ref_path << "\n";
+      return 1;
+    }
+
+  // Round-trip the corpus through each compression scheme which
+  // program is available.
+  for (CompressionSpec* s = compression_specs; s->program; ++s)
+    {
+      string cmd = string("command -v ") + s->program + " > /dev/null 2>&1";
+      if (system(cmd.c_str()))
+	{
+	  cerr << s->program << " is not available, skipping its test\n";
+	  continue;
+	}
+
+      string compressed_path = out_prefix + "test.abi" + s->extension;
+      string out_path = out_prefix + "test-" + s->program + ".abi";
+      cmd = "diff -u " + ref_path + " " + out_path;
+
+      bool is_ok = (write_corpus_to_file(corp, compressed_path)
+		    && read_compressed_corpus(compressed_path, s->kind,
+					      out_path)
+		    && system(cmd.c_str()) == 0);
+      emit_test_status_and_update_counters(is_ok, cmd, passed_count,
+					   failed_count, total_count);
+
+      // The content of a compressed file that is not named like an
+      // abixml file is not looked at.
+      string other_path = out_prefix + "test" + s->extension;
+      cmd = "guess_file_type " + other_path;
+      is_ok = (write_corpus_to_file(corp, other_path)
+	       && (abigail::tools_utils::guess_file_type(other_path)
+		   == abigail::tools_utils::FILE_TYPE_UNKNOWN));
+      emit_test_status_and_update_counters(is_ok, cmd, passed_count,
+					   failed_count, total_count);
+    }
+
+  // The failures of the compression program must be reported by the
+  // writer, rather than killing us or going unnoticed.
+  const char* path_env = getenv("PATH");
+  string saved_path = path_env ? path_env : "";
+
+  string empty_dir = out_prefix + "no-program";
+  string quitting_dir = out_prefix + "quitting-program";
+  bool is_ok = (abigail::tools_utils::ensure_dir_path_created(empty_dir)
+		&& abigail::tools_utils::ensure_dir_path_created(quitting_dir)
+		&& create_quitting_program(quitting_dir, "gzip"));
+
+  // The compression program can't be found.
+  setenv("PATH", empty_dir.c_str(), 1);
+  string cmd = "write to " + out_prefix + "missing.abi.gz";
+  bool test_is_ok = (is_ok
+		     && !write_corpus_to_file(corp,
+					      out_prefix + "missing.abi.gz"));
+  emit_test_status_and_update_counters(test_is_ok, cmd, passed_count,
+				       failed_count, total_count);
+
+  // The compression program exits before reading its input.
+  setenv("PATH", quitting_dir.c_str(), 1);
+  cmd = "write to " + out_prefix + "quitting.abi.gz";
+  test_is_ok = (is_ok
+		&& !write_corpus_to_file(corp,
+					 out_prefix + "quitting.abi.gz"));
+  emit_test_status_and_update_counters(test_is_ok, cmd, passed_count,
+				       failed_count, total_count);
+
+  setenv("PATH", saved_path.c_str(), 1);
+
+  emit_test_summary(total_count, passed_count, failed_count);
+
+  return failed_count;
+}
@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// -*- Mode: C++ -*-
+//
+// Copyright (C) 2023 Red Hat, Inc.
+
+/// @file
+///
+/// This program reads and compares ABI corpora with a cache of type
+/// comparison results that is much smaller than the default one, so
+/// that results get evicted from the cache.  It checks that the
+/// corpora and the comparison reports are the same as with the
+/// default cache.
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "abg-comparison.h"
+#include "abg-ir.h"
+#include "abg-reader.h"
+#include "abg-writer.h"
+#include "test-utils.h"
+
+using std::string;
+using std::ostringstream;
+using std::cerr;
+using abigail::ir::environment;
+using abigail::corpus_sptr;
+using abigail::comparison::diff_context;
+using abigail::comparison::diff_context_sptr;
+using abigail::comparison::corpus_diff_sptr;
+using abigail::comparison::compute_diff;
+using abigail::tests::emit_test_status_and_update_counters;
+using abigail::tests::emit_test_summary;
+
+/// The capacity of the small cache of type comparison results.
+static const size_t small_cache_capacity = 1024;
+
+/// This is an aggregate that specifies the ABI corpora to read and
+/// compare.
+struct InOutSpec
+{
+  const char*	in_path1;
+  /// The corpus to compare the first one against.  If it's empty,
+  /// the first corpus is only read and written back.
+  const char*	in_path2;
+};// end struct InOutSpec
+
+InOutSpec in_out_specs[] =
+{
+  {
+    "data/test-read-dwarf/test12-pr18844.so.abi",
+    ""
+  },
+  {
+    "data/test-read-dwarf/test-libandroid.so.abi",
+    ""
+  },
+  {
+    "data/test-abidiff/test-PR18791-v0.so.abi",
+    "data/test-abidiff/test-PR18791-v1.so.abi"
+  },
+  // This should be the last entry.
+  {0, 0}
+};
+
+/// Read an abixml corpus and emit it back, or emit the report of its
+/// comparison with another corpus.
+///
+/// @param env the environment to use.
+///
+/// @param path1 the path to the first abixml corpus.
+///
+/// @param path2 the path to the second abixml corpus, or the empty
+/// string if the first corpus is only to be emitted back.
+///
+/// @param out the output stream to emit to.
+///
+/// @return true iff the corpora could be read.
+static bool
+read_and_emit(environment& env,
+	      const string& path1,
+	      const string& path2,
+	      std::ostream& out)
+{
+  corpus_sptr corp1 = abigail::abixml::read_corpus_from_abixml_file(path1,
+								    env);
+  if (!corp1)
+    {
+      cerr << "could not read " << path1 << "\n";
+      return false;
+    }
+
+  if (path2.empty())
+    {
+      abigail::xml_writer::write_context_sptr ctxt =
+	abigail::xml_writer::create_write_context(env, out);
+      return abigail::xml_writer::write_corpus(*ctxt, corp1, /*indent=*/0);
+    }
+
+  corpus_sptr corp2 = abigail::abixml::read_corpus_from_abixml_file(path2,
+								    env);
+  if (!corp2)
+    {
+      cerr << "could not read " << path2 << "\n";
+      return false;
+    }
+
+  diff_context_sptr ctxt(new diff_context);
+  corpus_diff_sptr diff = compute_diff(corp1, corp2, ctxt);
+  diff->report(out);
+  return true;
+}
+
+int
+main()
+{
+  unsigned total_count = 0, passed_count = 0, failed_count = 0;
+
+  string src_prefix = string(abigail::tests::get_src_dir()) + "/tests/";
+  uint64_t evictions = 0;
+
+  for (InOutSpec* s = in_out_specs; s->in_path1; ++s)
+    {
+      string path1 = src_prefix + s->in_path1;
+      string path2 = *s->in_path2 ? src_prefix + s->in_path2 : "";
+
+      ostringstream ref_out, out;
+      bool is_ok = true;
+      {
+	environment env;
+	is_ok = read_and_emit(env, path1, path2, ref_out);
+      }
+      {
+	environment env;
+	env.type_comparison_cache_capacity(small_cache_capacity);
+	is_ok = is_ok && read_and_emit(env, path1, path2, out);
+	evictions += env.get_type_comparison_cache_stats().evictions;
+      }
+
+      if (is_ok && out.str() != ref_out.str())
+	{
+	  cerr << "the output for " << path1
+	       << " differs with a cache of type comparison results of "
+	       << small_cache_capacity << " entries\n";
+	  is_ok = false;
+	}
+
+      string cmd = "compare with small cache " + path1;
+      if (!path2.empty())
+	cmd += " " + path2;
+      emit_test_status_and_update_counters(is_ok, cmd, passed_count,
+					   failed_count, total_count);
+    }
+
+  // Make sure the eviction path of the cache was exercised.
+  bool is_ok = evictions > 0;
+  if (!is_ok)
+    cerr << "no result was evicted from the cache of type comparison "
+	 << "results\n";
+  emit_test_status_and_update_counters(is_ok, "evictions from small cache",
+				       passed_count, failed_count,
+				       total_count);
+
+  emit_test_summary(total_count, passed_count, failed_count);
+
+  return failed_count;
+}
@@ -19,6 +19,8 @@
 #include "abg-tools-utils.h"
 #include "abg-reader.h"
 #include "abg-dwarf-reader.h"
+#include "abg-elf-reader.h"
+#include "abg-workers.h"
 #ifdef WITH_CTF
 #include "abg-ctf-reader.h"
 #endif
@@ -52,6 +54,7 @@ using abigail::suppr::suppressions_type;
 using abigail::suppr::read_suppressions;
 
 using abigail::tools_utils::emit_prefix;
+using abigail::tools_utils::emit_memory_usage;
 using abigail::tools_utils::check_file;
 using abigail::tools_utils::guess_file_type;
 using abigail::tools_utils::gen_suppr_spec_from_headers;
@@ -95,6 +98,7 @@ struct options
   bool			show_relative_offset_changes;
   bool			show_stats_only;
   bool			show_symtabs;
+  bool			symbols_only;
   bool			show_deleted_fns;
   bool			show_changed_fns;
   bool			show_added_fns;
@@ -152,6 +156,7 @@ struct options
       show_relative_offset_changes(true),
       show_stats_only(),
       show_symtabs(),
+      symbols_only(),
       show_deleted_fns(),
       show_changed_fns(),
       show_added_fns(),
@@ -235,6 +240,8 @@ display_usage(const string& prog_name, ostream& out)
        "linux kernel abi whitelist\n"
     << " --stat  only display the diff stats\n"
     << " --symtabs  only display the symbol tables of the corpora\n"
+    << " --symbols-only  only compare the ELF symbols of the binaries, "
+    "without reading their debug info\n"
     << " --no-default-suppression  don't load any "
        "default suppression specification\n"
     << " --no-architecture  do not take architecture in account\n"
@@ -440,6 +447,8 @@ parse_command_line(int argc, char* argv[], options& opts)
 	opts.show_stats_only = true;
       else if (!strcmp(argv[i], "--symtabs"))
 	opts.show_symtabs = true;
+      else if (!strcmp(argv[i], "--symbols-only"))
+	opts.symbols_only = true;
       else if (!strcmp(argv[i], "--help")
 	       || !strcmp(argv[i], "-h"))
 	{
@@ -792,6 +801,10 @@ set_diff_context_from_opts(diff_context_sptr ctxt,
     (opts.show_symbols_not_referenced_by_debug_info);
   ctxt->show_added_symbols_unreferenced_by_debug_info
     (opts.show_symbols_not_referenced_by_debug_info && opts.show_added_syms);
+  // With --symbols-only, the symbol tables are all there is to
+  // compare, so the size, CRC, namespace and version of the symbols
+  // present in both binaries must be compared too.
+  ctxt->show_changed_symbols_unreferenced_by_debug_info(opts.symbols_only);
   ctxt->show_unreachable_types(opts.show_all_types);
   ctxt->show_impacted_interfaces(opts.show_impacted_interfaces);
 
@@ -946,7 +959,9 @@ set_native_xml_reader_options(abigail::fe_iface& rdr,
   abixml::consider_types_not_reachable_from_public_interfaces(rdr,
 							      opts.show_all_types);
   rdr.options().do_log = opts.do_log;
-
+  // Only one corpus is read at a time, so all the processors can
+  // be used to read it.
+  rdr.options().nb_worker_threads = abigail::workers::get_number_of_threads();
 }
 
 /// Set the regex patterns describing the functions to drop from the
@@ -1260,6 +1275,24 @@ main(int argc, char* argv[])
 	case abigail::tools_utils::FILE_TYPE_ELF: // fall through
 	case abigail::tools_utils::FILE_TYPE_AR:
 	  {
+	    if (opts.symbols_only)
+	      {
+		// Only the ELF symbols are compared, so use the plain
+		// ELF reader, which doesn't look for debug info.
+		abigail::elf::reader rdr(opts.file1,
+					 opts.prepared_di_root_paths1,
+					 env);
+		// In a Linux kernel binary, only the symbols of the
+		// ksymtab are exported.
+		rdr.options().load_in_linux_kernel_mode =
+		  opts.linux_kernel_mode;
+		set_suppressions(rdr, opts);
+		c1 = rdr.read_corpus(c1_status);
+		if (!c1)
+		  return handle_error(c1_status, /*ctxt=*/0, argv[0], opts);
+		break;
+	      }
+
 	    corpus::origin requested_fe_kind = corpus::DWARF_ORIGIN;
 #ifdef WITH_CTF
 	    if (opts.use_ctf)
@@ -1337,6 +1370,24 @@ main(int argc, char* argv[])
 	case abigail::tools_utils::FILE_TYPE_ELF: // Fall through
 	case abigail::tools_utils::FILE_TYPE_AR:
 	  {
+	    if (opts.symbols_only)
+	      {
+		// Only the ELF symbols are compared, so use the plain
+		// ELF reader, which doesn't look for debug info.
+		abigail::elf::reader rdr(opts.file2,
+					 opts.prepared_di_root_paths2,
+					 env);
+		// In a Linux kernel binary, only the symbols of the
+		// ksymtab are exported.
+		rdr.options().load_in_linux_kernel_mode =
+		  opts.linux_kernel_mode;
+		set_suppressions(rdr, opts);
+		c2 = rdr.read_corpus(c2_status);
+		if (!c2)
+		  return handle_error(c2_status, /*ctxt=*/0, argv[0], opts);
+		break;
+	      }
+
 	    corpus::origin requested_fe_kind = corpus::DWARF_ORIGIN;
 #ifdef WITH_CTF
 	    if (opts.use_ctf)
@@ -1494,6 +1545,14 @@ main(int argc, char* argv[])
 	      std::cerr << "diff computed!:" << t << "\n";
 	    }
 
+	  if (opts.show_stats)
+	    {
+	      ir::memory_usage_vector usage;
+	      env.get_memory_usage(usage);
+	      ctxt->get_memory_usage(usage);
+	      emit_memory_usage(argv[0], usage, cerr);
+	    }
+
 	  if (opts.do_log)
 	    {
 	      t.start();
@@ -1592,6 +1651,14 @@ main(int argc, char* argv[])
 	      std::cerr << "diff computed!:" << t << "\n";
 	    }
 
+	  if (opts.show_stats)
+	    {
+	      ir::memory_usage_vector usage;
+	      env.get_memory_usage(usage);
+	      ctxt->get_memory_usage(usage);
+	      emit_memory_usage(argv[0], usage, cerr);
+	    }
+
 	  if (opts.do_log)
 	    {
 	      std::cerr << "Computing net changes ...\n";
@@ -41,11 +41,11 @@ using std::string;
 using std::cerr;
 using std::cout;
 using std::ostream;
-using std::ofstream;
 using std::vector;
 using std::shared_ptr;
 using abg_compat::optional;
 using abigail::tools_utils::emit_prefix;
+using abigail::tools_utils::emit_memory_usage;
 using abigail::tools_utils::temp_file;
 using abigail::tools_utils::temp_file_sptr;
 using abigail::tools_utils::check_file;
@@ -71,6 +71,9 @@ using abigail::xml_writer::create_write_context;
 using abigail::xml_writer::type_id_style_kind;
 using abigail::xml_writer::write_context_sptr;
 using abigail::xml_writer::write_corpus;
+using abigail::xml_writer::set_output_file;
+using abigail::xml_writer::close_output_file;
+using abigail::xml_writer::get_nb_bytes_written_to_output_file;
 using abigail::abixml::read_corpus_from_abixml_file;
 
 using namespace abigail;
@@ -566,6 +569,33 @@ set_generic_options(abigail::elf_based_reader& rdr, options& opts)
     opts.assume_odr_for_cplusplus;
 }
 
+/// Emit the time it took to write the abixml output file, as well as
+/// the resulting throughput.
+///
+/// @param prog_name the name of the program.
+///
+/// @param ctxt the write context used to emit the abixml output.
+///
+/// @param t the timer that measured the emission of the output.
+static void
+emit_output_throughput(const char* prog_name,
+		       const xml_writer::write_context& ctxt,
+		       const timer& t)
+{
+  time_t h = 0, m = 0, s = 0, ms = 0;
+  t.value(h, m, s, ms);
+  double seconds = (h * 3600 + m * 60 + s) + ms / 1000.0;
+  double mbytes =
+    get_nb_bytes_written_to_output_file(ctxt) / (1024.0 * 1024.0);
+
+  emit_prefix(prog_name, cerr)
+    << "emitted abixml output in: " << t
+    << " (" << mbytes << " MB";
+  if (seconds > 0)
+    cerr << ", " << mbytes / seconds << " MB/s";
+  cerr << ")\n";
+}
+
 /// Load an ABI @ref corpus (the internal representation of the ABI of
 /// a binary) and write it out as an abixml.
 ///
@@ -720,6 +750,14 @@ load_corpus_and_write_abixml(char* argv[],
       return 1;
     }
 
+  if (opts.show_stats)
+    {
+      ir::memory_usage_vector usage;
+      env.get_memory_usage(usage);
+      reader->get_memory_usage(usage);
+      emit_memory_usage(argv[0], usage, cerr);
+    }
+
   // Clear some resources to gain back some space.
   t.start();
   reader.reset();
@@ -756,6 +794,15 @@ load_corpus_and_write_abixml(char* argv[],
 #endif
       fe_iface_sptr rdr = abixml::create_reader(tmp_file->get_path(), env);
 
+      // The types read back are expected to have the canonical types
+      // they were emitted from.  Let the reader know about them so
+      // that they are compared against those first.
+      {
+	unordered_map<string, type_base*> hints;
+	xml_writer::get_canonical_types_of_type_ids(*write_ctxt, hints);
+	abixml::set_canonical_type_hints(*rdr, std::move(hints));
+      }
+
 #ifdef WITH_DEBUG_SELF_COMPARISON
       if (opts.debug_abidiff
           && !opts.type_id_file_path.empty())
@@ -812,22 +859,26 @@ load_corpus_and_write_abixml(char* argv[],
 
   if (!opts.out_file_path.empty())
     {
-      ofstream of(opts.out_file_path.c_str(), std::ios_base::trunc);
-      if (!of.is_open())
+      if (!set_output_file(*write_ctxt, opts.out_file_path))
         {
           emit_prefix(argv[0], cerr)
             << "could not open output file '"
             << opts.out_file_path << "'\n";
           return 1;
         }
-      set_ostream(*write_ctxt, of);
       t.start();
       write_corpus(*write_ctxt, corp, 0);
+      bool is_ok = close_output_file(*write_ctxt);
       t.stop();
       if (opts.do_log)
-        emit_prefix(argv[0], cerr)
-          << "emitted abixml output in: " << t << "\n";
-      of.close();
+	emit_output_throughput(argv[0], *write_ctxt, t);
+      if (!is_ok)
+        {
+          emit_prefix(argv[0], cerr)
+            << "could not write output file '"
+            << opts.out_file_path << "'\n";
+          return 1;
+        }
       return 0;
     }
   else
@@ -914,8 +965,7 @@ load_kernel_corpus_group_and_write_abixml(char* argv[],
 
       if (!opts.out_file_path.empty())
 	{
-	  ofstream of(opts.out_file_path.c_str(), std::ios_base::trunc);
-	  if (!of.is_open())
+	  if (!set_output_file(*ctxt, opts.out_file_path))
 	    {
 	      emit_prefix(argv[0], cerr)
 		<< "could not open output file '"
@@ -926,13 +976,18 @@ load_kernel_corpus_group_and_write_abixml(char* argv[],
 	  if (opts.do_log)
 	    emit_prefix(argv[0], cerr)
 	      << "emitting the abixml output ...\n";
-	  set_ostream(*ctxt, of);
 	  t.start();
 	  exit_code = !write_corpus_group(*ctxt, group, 0);
+	  if (!close_output_file(*ctxt))
+	    {
+	      emit_prefix(argv[0], cerr)
+		<< "could not write output file '"
+		<< opts.out_file_path << "'\n";
+	      exit_code = 1;
+	    }
 	  t.stop();
 	  if (opts.do_log)
-	    emit_prefix(argv[0], cerr)
-	      << "emitted abixml output in: " << t << "\n";
+	    emit_output_throughput(argv[0], *ctxt, t);
 	}
       else
 	{
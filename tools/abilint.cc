@@ -33,6 +33,7 @@
 #endif
 #include "abg-writer.h"
 #include "abg-suppression.h"
+#include "abg-workers.h"
 
 using std::string;
 using std::cerr;
@@ -733,6 +734,8 @@ main(int argc, char* argv[])
 	    abigail::abixml::create_reader(&cin, env);
 	  assert(rdr);
 	  set_suppressions(*rdr, opts);
+	  rdr->options().nb_worker_threads =
+	    abigail::workers::get_number_of_threads();
 	  abigail::fe_iface::status sts;
 	  corpus_sptr corp = rdr->read_corpus(sts);
 	  if (!opts.noout)
@@ -798,6 +801,8 @@ main(int argc, char* argv[])
 	      abigail::abixml::create_reader(opts.file_path, env);
 	    assert(rdr);
 	    set_suppressions(*rdr, opts);
+	    rdr->options().nb_worker_threads =
+	      abigail::workers::get_number_of_threads();
 	    corp = rdr->read_corpus(s);
 	    break;
 	  }
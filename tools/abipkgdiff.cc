@@ -1775,6 +1775,7 @@ compare_to_self(const elf_file&		elf,
       }
     ofstream of(abi_file_path.c_str(), std::ios_base::trunc);
 
+    unordered_map<string, abigail::ir::type_base*> canonical_type_hints;
     {
       const abigail::xml_writer::write_context_sptr c =
 	abigail::xml_writer::create_write_context(env, of);
@@ -1797,6 +1798,8 @@ compare_to_self(const elf_file&		elf,
 
       of.flush();
       of.close();
+      abigail::xml_writer::get_canonical_types_of_type_ids(*c,
+							   canonical_type_hints);
 
       if (opts.verbose)
 	emit_prefix("abipkgdiff", cerr)
@@ -1817,6 +1820,11 @@ compare_to_self(const elf_file&		elf,
 	  return abigail::tools_utils::ABIDIFF_ERROR;
 	}
 
+      // The types read back are expected to have the canonical types
+      // they were emitted from.  Let the reader know about them so
+      // that they are compared against those first.
+      abixml::set_canonical_type_hints(*rdr, std::move(canonical_type_hints));
+
       if (opts.verbose)
 	emit_prefix("abipkgdiff", cerr)
 	  << "Reading ABIXML file '"
@@ -3887,8 +3895,22 @@ main(int argc, char* argv[])
 	      | abigail::tools_utils::ABIDIFF_ERROR);
     }
 
+  abidiff_status status = abigail::tools_utils::ABIDIFF_OK;
   if (opts.self_check)
-    return compare_to_self(first_package, opts);
+    status = compare_to_self(first_package, opts);
+  else
+    status = compare(first_package, second_package, opts);
 
-  return compare(first_package, second_package, opts);
+  if (opts.verbose)
+    {
+      abigail::tools_utils::debug_info_probe_stats stats =
+	abigail::tools_utils::get_debug_info_probe_stats();
+      emit_prefix("abipkgdiff", cerr)
+	<< "binaries probed for debug info: " << stats.nb_probes
+	<< ", probes answered from cache: " << stats.nb_cached_probes
+	<< ", bytes decompressed by probes: "
+	<< stats.nb_decompressed_bytes << "\n";
+    }
+
+  return status;
 }
@@ -28,7 +28,7 @@ using std::ostringstream;
 using std::vector;
 
 using abigail::ir::environment;
-using abigail::dwarf::lookup_symbol_from_elf;
+using abigail::dwarf::lookup_symbols_from_elf;
 using abigail::elf_symbol;
 using abigail::elf_symbol_sptr;
 
@@ -37,7 +37,7 @@ struct options
   bool	show_help;
   bool	display_version;
   char* elf_path;
-  char* symbol_name;
+  vector<char*> symbol_names;
   bool	demangle;
   bool absolute_path;
 
@@ -45,7 +45,6 @@ struct options
     : show_help(false),
       display_version(false),
       elf_path(0),
-      symbol_name(0),
       demangle(false),
       absolute_path(true)
   {}
@@ -54,7 +53,8 @@ struct options
 static void
 display_usage(const string& prog_name, ostream &out)
 {
-  out << "usage: " << prog_name << " [options] <elf file> <symbol-name>\n"
+  out << "usage: " << prog_name
+      << " [options] <elf file> <symbol-name> [<symbol-name>...]\n"
       << "where [options] can be:\n"
       << "  --help  display this help string\n"
       << "  --version|-v  display program version information and exit\n"
@@ -77,13 +77,8 @@ parse_command_line(int argc, char* argv[], options& opts)
 	{
 	  if (!opts.elf_path)
 	    opts.elf_path = argv[i];
-	  else if (!opts.symbol_name)
-	    opts.symbol_name = argv[i] ;
 	  else
-	    {
-	      opts.show_help = true;
-	      return;
-	    }
+	    opts.symbol_names.push_back(argv[i]);
 	}
       else if (!strcmp(argv[i], "--help")
 	       || !strcmp(argv[i], "-h"))
@@ -127,46 +122,58 @@ main(int argc, char* argv[])
     }
 
   assert(opts.elf_path != 0
-	 && opts.symbol_name != 0);
+	 && !opts.symbol_names.empty());
 
-  string p = opts.elf_path, n = opts.symbol_name;
+  string p = opts.elf_path;
+  vector<string> names(opts.symbol_names.begin(), opts.symbol_names.end());
   environment env;
-  vector<elf_symbol_sptr> syms;
-  if (!lookup_symbol_from_elf(env, p, n, opts.demangle, syms))
-    {
-      cout << "could not find symbol '"
-	   << opts.symbol_name
-	   << "' in file '";
-      if (opts.absolute_path)
-	cout << opts.elf_path << "'\n";
-      else
-	cout << basename(opts.elf_path);
-      return 0;
-    }
+  // Look all the symbols up at once, so that the ELF file and its
+  // symbol lookup tables are only set up once.
+  vector<vector<elf_symbol_sptr>> found_syms;
+  lookup_symbols_from_elf(env, p, names, opts.demangle, found_syms);
+  found_syms.resize(names.size());
 
-  elf_symbol_sptr sym = syms[0];
-  cout << "found symbol '" << n << "'";
-  if (n != sym->get_name())
-    cout << " (" << sym->get_name() << ")";
-  cout << ", an instance of "
-       << (elf_symbol::type) sym->get_type()
-       << " of " << sym->get_binding();
-  if (syms.size() > 1 || !sym->get_version().is_empty())
+  for (size_t s = 0; s < names.size(); ++s)
     {
-      cout << ", of version";
-      if (syms.size () > 1)
-	cout << "s";
-      cout << " ";
-      for (vector<elf_symbol_sptr>::const_iterator i = syms.begin();
-	   i != syms.end();
-	   ++i)
+      const string& n = names[s];
+      const vector<elf_symbol_sptr>& syms = found_syms[s];
+      if (syms.empty())
 	{
-	  if (i != syms.begin())
-	    cout << ", ";
-	  cout << "'" << (*i)->get_version().str() << "'";
+	  cout << "could not find symbol '"
+	       << n
+	       << "' in file '";
+	  if (opts.absolute_path)
+	    cout << opts.elf_path;
+	  else
+	    cout << basename(opts.elf_path);
+	  cout << "'\n";
+	  continue;
+	}
+
+      elf_symbol_sptr sym = syms[0];
+      cout << "found symbol '" << n << "'";
+      if (n != sym->get_name())
+	cout << " (" << sym->get_name() << ")";
+      cout << ", an instance of "
+	   << (elf_symbol::type) sym->get_type()
+	   << " of " << sym->get_binding();
+      if (syms.size() > 1 || !sym->get_version().is_empty())
+	{
+	  cout << ", of version";
+	  if (syms.size () > 1)
+	    cout << "s";
+	  cout << " ";
+	  for (vector<elf_symbol_sptr>::const_iterator i = syms.begin();
+	       i != syms.end();
+	       ++i)
+	    {
+	      if (i != syms.begin())
+		cout << ", ";
+	      cout << "'" << (*i)->get_version().str() << "'";
+	    }
 	}
+      cout << '\n';
     }
-  cout << '\n';
 
   return 0;
 }
@@ -55,6 +55,7 @@ struct options
   bool			display_usage;
   bool			display_version;
   bool			verbose;
+  bool			show_stats;
   bool			missing_operand;
   bool			perform_change_categorization;
   bool			leaf_changes_only;
@@ -84,6 +85,7 @@ struct options
     : display_usage(),
       display_version(),
       verbose(),
+      show_stats(),
       missing_operand(),
       perform_change_categorization(true),
       leaf_changes_only(true),
@@ -115,6 +117,7 @@ display_usage(const string& prog_name, ostream& out)
     << " --help|-h  display this message\n"
     << " --version|-v  display program version information and exit\n"
     << " --verbose  display verbose messages\n"
+    << " --stats  show statistics about various internal stuff\n"
     << " --debug-info-dir1|--d1 <path> the root for the debug info of "
 	"the first kernel\n"
     << " --debug-info-dir2|--d2 <path> the root for the debug info of "
@@ -174,6 +177,8 @@ parse_command_line(int argc, char* argv[], options& opts)
 	}
       else if (!strcmp(argv[i], "--verbose"))
 	  opts.verbose = true;
+      else if (!strcmp(argv[i], "--stats"))
+	opts.show_stats = true;
       else if (!strcmp(argv[i], "--version")
 	       || !strcmp(argv[i], "-v"))
 	{
@@ -519,6 +524,14 @@ main(int argc, char* argv[])
       if (diff->has_incompatible_changes())
 	status |= abigail::tools_utils::ABIDIFF_ABI_INCOMPATIBLE_CHANGE;
 
+      if (opts.show_stats)
+	{
+	  memory_usage_vector usage;
+	  env.get_memory_usage(usage);
+	  diff_ctxt->get_memory_usage(usage);
+	  emit_memory_usage(argv[0], usage, cerr);
+	}
+
       if (diff->has_changes())
 	diff->report(cout);
     }